@@ -0,0 +1,384 @@
+// File name: Analysis.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of classes in "Analysis.hpp"
+// Last Changed: 10/19/26
+
+#include "Analysis.hpp"
+#include <string>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// most steps of Brent's method taken to refine a root or extremum
+static const size_t MAX_REFINE_STEPS = 40;
+
+// sums of fewer values than this are added in a plain loop
+static const size_t PAIRWISE_BLOCK = 32;
+
+// independent partial sums kept by that loop
+static const size_t PAIRWISE_LANES = 4;
+
+// golden section ratio used by Brent's minimization
+static const double GOLDEN = 0.3819660112501051;
+
+
+// pairwiseSum helper function
+// post: returns sum of values, added as a balanced tree so rounding error grows with log(count). Short
+// runs are added into PAIRWISE_LANES separate sums, which the compiler can keep in one vector register
+static double pairwiseSum(const double *values, size_t count) {
+    if (count <= PAIRWISE_BLOCK) {
+        double lanes[PAIRWISE_LANES] = {0, 0, 0, 0};
+        size_t index = 0;
+        for (; index + PAIRWISE_LANES <= count; index += PAIRWISE_LANES) {
+            for (size_t lane = 0; lane < PAIRWISE_LANES; lane++) {
+                lanes[lane] += values[index + lane];
+            }
+        }
+        for (; index < count; index++) {
+            lanes[0] += values[index];
+        }
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    size_t half = count/2;
+    return pairwiseSum(values, half) + pairwiseSum(values + half, count - half);
+}
+
+
+// brentRoot helper function
+// pre: f(a) and f(b) have opposite signs, or one of them is 0
+// post: returns root of f between a and b
+static double brentRoot(const function<double(double)> &f, double a, double b) {
+    double fa = f(a), fb = f(b);
+    if (fa == 0) {
+        return a;
+    }
+    if (fb == 0) {
+        return b;
+    }
+    double c = a, fc = fa, d = b - a, e = d;
+    for (size_t step = 0; step < MAX_REFINE_STEPS; step++) {
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        double tol = 2e-16*std::fabs(b) + 1e-15;
+        double m = 0.5*(c - b);
+        if (std::fabs(m) <= tol || fb == 0) {
+            break;
+        }
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            // inverse quadratic interpolation, or secant when only two points are distinct
+            double s = fb/fa, p, q;
+            if (a == c) {
+                p = 2*m*s;
+                q = 1 - s;
+            }
+            else {
+                double r = fb/fc;
+                q = fa/fc;
+                p = s*(2*m*q*(q - r) - (b - a)*(r - 1));
+                q = (q - 1)*(r - 1)*(s - 1);
+            }
+            if (p > 0) {
+                q = -q;
+            }
+            else {
+                p = -p;
+            }
+            if (2*p < std::min(3*m*q - std::fabs(tol*q), std::fabs(e*q))) {
+                e = d;
+                d = p/q;
+            }
+            else {
+                d = e = m;
+            }
+        }
+        else {
+            d = e = m;
+        }
+        a = b;
+        fa = fb;
+        b += std::fabs(d) > tol ? d : (m > 0 ? tol : -tol);
+        fb = f(b);
+    }
+    return b;
+}
+
+
+// brentMinimum helper function
+// pre: a < x < b and f(x) < f(a), f(x) < f(b)
+// post: returns x of the minimum of f between a and b
+static double brentMinimum(const function<double(double)> &f, double a, double x, double b) {
+    double w = x, v = x, fx = f(x), fw = fx, fv = fx, d = 0, e = 0;
+    for (size_t step = 0; step < MAX_REFINE_STEPS; step++) {
+        double middle = 0.5*(a + b);
+        double tol = 1e-10*std::fabs(x) + 1e-12;
+        if (std::fabs(x - middle) <= 2*tol - 0.5*(b - a)) {
+            break;
+        }
+        bool golden = true;
+        if (std::fabs(e) > tol) {
+            // parabola through x, w and v
+            double r = (x - w)*(fx - fv);
+            double q = (x - v)*(fx - fw);
+            double p = (x - v)*q - (x - w)*r;
+            q = 2*(q - r);
+            if (q > 0) {
+                p = -p;
+            }
+            q = std::fabs(q);
+            if (std::fabs(p) < std::fabs(0.5*q*e) && p > q*(a - x) && p < q*(b - x)) {
+                e = d;
+                d = p/q;
+                golden = false;
+            }
+        }
+        if (golden) {
+            e = (x < middle) ? b - x : a - x;
+            d = GOLDEN*e;
+        }
+        double u = x + (std::fabs(d) >= tol ? d : (d > 0 ? tol : -tol));
+        double fu = f(u);
+        if (fu <= fx) {
+            if (u < x) {
+                b = x;
+            }
+            else {
+                a = x;
+            }
+            v = w; fv = fw;
+            w = x; fw = fx;
+            x = u; fx = fu;
+        }
+        else {
+            if (u < x) {
+                a = u;
+            }
+            else {
+                b = u;
+            }
+            if (fu <= fw || w == x) {
+                v = w; fv = fw;
+                w = u; fw = fu;
+            }
+            else if (fu <= fv || v == x || v == w) {
+                v = u; fv = fu;
+            }
+        }
+    }
+    return x;
+}
+
+
+// alternate ctor
+// pre: curve evaluates the function being sampled
+// post: CurveAnalyzer exists with no samples
+CurveAnalyzer::CurveAnalyzer(function<double(double)> curve) :
+curve(curve),
+carried(0),
+carriedX(0),
+carriedY(0),
+slopeSign(0),
+slopeLeft(0),
+slopeRight(0),
+firstX(0),
+lastX(0),
+sampleCount(0),
+skippedIntervals(0),
+integral(0)
+{
+    // nothing to do
+}
+
+
+// addSamples
+// pre: xs is increasing and continues from the previous batch, ys[i] = curve(xs[i])
+// post: sign changes, samples at 0 and slope changes in the batch are recorded and its trapezoids are
+// summed
+void CurveAnalyzer::addSamples(const double *xs, const double *ys, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (sampleCount == 0) {
+        firstX = xs[0];
+    }
+    sampleCount += count;
+    lastX = xs[count - 1];
+    
+    // samples of this batch, preceded by the one carried over from the last batch
+    size_t total = carried + count;
+    x.resize(total);
+    y.resize(total);
+    x[0] = carriedX;
+    y[0] = carriedY;
+    std::copy(xs, xs + count, x.begin() + carried);
+    std::copy(ys, ys + count, y.begin() + carried);
+    
+    // flag every interval in one pass, without branching on the data. A sign change is strict, since a
+    // sample exactly at 0 is a root of its own. An undefined interval has slope sign 2
+    trapezoids.assign(total, 0.0);
+    signChange.assign(total, 0);
+    slopeSigns.assign(total, 0);
+    for (size_t index = 1; index < total; index++) {
+        bool finite = std::isfinite(y[index]) & std::isfinite(y[index - 1]);
+        trapezoids[index] = finite ? 0.5*(x[index] - x[index - 1])*(y[index] + y[index - 1]) : 0.0;
+        signChange[index] = finite & (((y[index] < 0) & (y[index - 1] > 0)) | ((y[index] > 0) & (y[index - 1] < 0)));
+        double step = y[index] - y[index - 1];
+        slopeSigns[index] = finite ? (step > 0) - (step < 0) : 2;
+    }
+    
+    // the carried sample and the interval ending in it were already handled with the last batch. The
+    // slope sign is carried from one rising or falling interval to the next, so flat intervals between
+    // them don't hide the slope change
+    for (size_t index = carried; index < total; index++) {
+        if (y[index] == 0) {
+            rootBrackets.push_back(x[index]);
+            rootBrackets.push_back(x[index]);
+        }
+        if (index == 0) {
+            continue;
+        }
+        skippedIntervals += slopeSigns[index] == 2;
+        if (signChange[index]) {
+            rootBrackets.push_back(x[index - 1]);
+            rootBrackets.push_back(x[index]);
+        }
+        if (slopeSigns[index] == 2) {
+            slopeSign = 0;
+        }
+        else if (slopeSigns[index] != 0) {
+            if (slopeSign == -slopeSigns[index]) {
+                extremumBrackets.push_back(slopeLeft);
+                extremumBrackets.push_back(slopeRight);
+                extremumBrackets.push_back(x[index]);
+                isMaximum.push_back(slopeSign > 0);
+            }
+            slopeSign = slopeSigns[index];
+            slopeLeft = x[index - 1];
+            slopeRight = x[index];
+        }
+    }
+    size_t firstNew = std::max<size_t>(carried, 1);
+    batchIntegrals.push_back(pairwiseSum(trapezoids.data() + firstNew, total - firstNew));
+    
+    // carry the last sample into the next batch
+    carried = 1;
+    carriedX = x[total - 1];
+    carriedY = y[total - 1];
+}
+
+
+// finish
+// pre: every sample has been added
+// post: roots and extrema are refined and the integral is totalled
+void CurveAnalyzer::finish() {
+    roots.clear();
+    minima.clear();
+    maxima.clear();
+    for (size_t index = 0; index < rootBrackets.size(); index += 2) {
+        double left = rootBrackets[index], right = rootBrackets[index + 1];
+        double fLeft = curve(left), fRight = curve(right);
+        double root = brentRoot(curve, left, right);
+        // a sign change across a pole (e.g. tan) is not a root: |f| grows instead of shrinking
+        if (!(std::fabs(curve(root)) <= std::min(std::fabs(fLeft), std::fabs(fRight)))) {
+            continue;
+        }
+        roots.push_back(root);
+    }
+    for (size_t index = 0; index < isMaximum.size(); index++) {
+        double left = extremumBrackets[3*index];
+        double middle = extremumBrackets[3*index + 1];
+        double right = extremumBrackets[3*index + 2];
+        double sign = isMaximum[index] ? -1 : 1;
+        function<double(double)> f = [this, sign](double xVal) { return sign*curve(xVal); };
+        double extremum = brentMinimum(f, left, middle, right);
+        // near a smooth extremum, refining can't gain more than the rise from the middle sample to the
+        // ends. A slope change across a pole (e.g. tan) gains without bound, so it is not an extremum
+        double gain = f(middle) - f(extremum);
+        double rise = std::max(f(left), f(right)) - f(middle);
+        if (!(gain <= rise)) {
+            continue;
+        }
+        if (isMaximum[index]) {
+            maxima.push_back(extremum);
+        }
+        else {
+            minima.push_back(extremum);
+        }
+    }
+    // batches arrive one at a time, so their sums are added here, on the calling thread
+    integral = pairwiseSum(batchIntegrals.data(), batchIntegrals.size());
+}
+
+
+// getRoots
+// pre: finish has been called
+// post: returns x of every root found, in increasing order
+const vector<double>& CurveAnalyzer::getRoots() const {
+    return roots;
+}
+
+
+// getMinima
+// pre: finish has been called
+// post: returns x of every local minimum found, in increasing order
+const vector<double>& CurveAnalyzer::getMinima() const {
+    return minima;
+}
+
+
+// getMaxima
+// pre: finish has been called
+// post: returns x of every local maximum found, in increasing order
+const vector<double>& CurveAnalyzer::getMaxima() const {
+    return maxima;
+}
+
+
+// getIntegral
+// pre: finish has been called
+// post: returns the trapezoid rule integral from the first to the last sample
+double CurveAnalyzer::getIntegral() const {
+    return integral;
+}
+
+
+// print
+// pre: finish has been called
+// post: writes roots, extrema and integral to filename
+void CurveAnalyzer::print(string filename, string polynomial) const {
+    ofstream outfile;
+    outfile.open(filename, ios::ate);
+    outfile.precision(10);
+    
+    // formatting...
+    outfile << "f(x) = " << polynomial << endl;
+    outfile << "Samples: " << sampleCount << " | " << firstX << " <= x <= " << lastX << endl << endl;
+    
+    outfile << "Roots: " << roots.size() << endl;
+    for (size_t index = 0; index < roots.size(); index++) {
+        outfile << "x = " << roots[index] << endl;
+    }
+    outfile << endl << "Local minima: " << minima.size() << endl;
+    for (size_t index = 0; index < minima.size(); index++) {
+        outfile << "(" << minima[index] << " , " << curve(minima[index]) << ")" << endl;
+    }
+    outfile << endl << "Local maxima: " << maxima.size() << endl;
+    for (size_t index = 0; index < maxima.size(); index++) {
+        outfile << "(" << maxima[index] << " , " << curve(maxima[index]) << ")" << endl;
+    }
+    outfile << endl << "Integral from " << firstX << " to " << lastX << " = " << integral << endl;
+    if (skippedIntervals != 0) {
+        outfile << skippedIntervals << " intervals with undefined values were left out of the integral" << endl;
+    }
+    
+    outfile.close();
+}
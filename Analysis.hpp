@@ -0,0 +1,104 @@
+// File name: Analysis.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: CurveAnalyzer finds the roots, local extrema and definite integral of a function from the
+// samples taken while graphing it, so the function doesn't have to be sampled a second time.
+// Each batch of samples is scanned for sign changes and samples exactly at 0 (roots) and slope changes
+// (extrema), and its trapezoids are added up with pairwise summation over independent lanes. Once sampling is done, every
+// bracket found is refined with a few steps of Brent's method, and the batch sums are added pairwise into
+// the integral, serially, since batches arrive one at a time.
+// Last Changed: 10/19/26
+
+#ifndef Analysis_hpp
+#define Analysis_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <functional>
+
+class CurveAnalyzer {
+private:
+    // function being analyzed, used to refine roots and extrema
+    std::function<double(double)> curve;
+    
+    // last sample of the previous batch, so brackets spanning two batches are found
+    size_t carried;
+    double carriedX, carriedY;
+    
+    // sign (-1 or 1) and ends of the last interval over which the samples rose or fell, carried across
+    // flat intervals and batches so an extremum sampled on a flat step is still bracketed. 0 before the
+    // first such interval and after an undefined one
+    int slopeSign;
+    double slopeLeft, slopeRight;
+    
+    // [left, right] brackets holding a sign change
+    std::vector<double> rootBrackets;
+    
+    // [left, middle, right] brackets where the slope changes sign, and whether each is a maximum
+    std::vector<double> extremumBrackets;
+    std::vector<bool> isMaximum;
+    
+    // samples, trapezoids, flags and slope signs of the batch being scanned, kept so each batch reuses
+    // their storage
+    std::vector<double> x, y, trapezoids;
+    std::vector<char> signChange;
+    std::vector<signed char> slopeSigns;
+    
+    // pairwise sum of the trapezoids in each batch
+    std::vector<double> batchIntegrals;
+    double firstX, lastX;
+    size_t sampleCount;
+    size_t skippedIntervals;
+    
+    // results, set by finish
+    std::vector<double> roots;
+    std::vector<double> minima, maxima;
+    double integral;
+    
+public:
+    
+    // alternate ctor
+    // pre: curve evaluates the function being sampled
+    // post: CurveAnalyzer exists with no samples
+    CurveAnalyzer(std::function<double(double)> curve);
+    
+    // addSamples
+    // pre: xs is increasing and continues from the previous batch, ys[i] = curve(xs[i])
+    // post: sign changes, samples at 0 and slope changes in the batch are recorded and its trapezoids are
+    // summed
+    void addSamples(const double *xs, const double *ys, size_t count);
+    
+    // finish
+    // pre: every sample has been added
+    // post: roots and extrema are refined and the integral is totalled
+    void finish();
+    
+    // getRoots
+    // pre: finish has been called
+    // post: returns x of every root found, in increasing order
+    const std::vector<double>& getRoots() const;
+    
+    // getMinima
+    // pre: finish has been called
+    // post: returns x of every local minimum found, in increasing order
+    const std::vector<double>& getMinima() const;
+    
+    // getMaxima
+    // pre: finish has been called
+    // post: returns x of every local maximum found, in increasing order
+    const std::vector<double>& getMaxima() const;
+    
+    // getIntegral
+    // pre: finish has been called
+    // post: returns the trapezoid rule integral from the first to the last sample
+    double getIntegral() const;
+    
+    // print
+    // pre: finish has been called
+    // post: writes roots, extrema and integral to filename
+    void print(std::string filename, std::string polynomial) const;
+};
+
+
+#endif /* Analysis_hpp */
@@ -0,0 +1,66 @@
+// File name: Dual.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Dual is a dual number, value + slope*e where e*e = 0. Each operation on Dual numbers applies
+// the chain rule, so evaluating a function at Dual(x, 1) gives f(x) as the value and f'(x) as the slope,
+// exactly and in the same pass. The value is computed with the same operations, in the same order, as the
+// double it stands in for, so it is bit for bit the same.
+// Last Changed: 10/19/26
+
+#ifndef Dual_hpp
+#define Dual_hpp
+
+#include <cmath>
+#include "FastMath.hpp"
+
+struct Dual {
+    double value, slope;
+
+    // default ctor
+    // post: Dual is the constant 0
+    Dual() : value(0), slope(0) {}
+
+    // alternate ctor
+    // post: Dual is value + slope*e
+    Dual(double value, double slope) : value(value), slope(slope) {}
+};
+
+// operator+
+// post: returns lhs + rhs
+inline Dual operator+(const Dual &lhs, const Dual &rhs) {
+    return Dual(lhs.value + rhs.value, lhs.slope + rhs.slope);
+}
+
+// operator*
+// post: returns lhs*rhs, by the product rule
+inline Dual operator*(const Dual &lhs, const Dual &rhs) {
+    return Dual(lhs.value*rhs.value, lhs.slope*rhs.value + lhs.value*rhs.slope);
+}
+
+// dualPow
+// post: returns base^exponent, by the power rule
+inline Dual dualPow(const Dual &base, int exponent) {
+    return Dual(std::pow(base.value, exponent), exponent*std::pow(base.value, exponent - 1)*base.slope);
+}
+
+// dualSin
+// post: returns sin(angle), evaluated to the given precision
+inline Dual dualSin(const Dual &angle, Precision precision) {
+    return Dual(fastSin(angle.value, precision), fastCos(angle.value, precision)*angle.slope);
+}
+
+// dualCos
+// post: returns cos(angle), evaluated to the given precision
+inline Dual dualCos(const Dual &angle, Precision precision) {
+    return Dual(fastCos(angle.value, precision), -fastSin(angle.value, precision)*angle.slope);
+}
+
+// dualTan
+// post: returns tan(angle), evaluated to the given precision
+inline Dual dualTan(const Dual &angle, Precision precision) {
+    double tangent = fastTan(angle.value, precision);
+    return Dual(tangent, (1 + tangent*tangent)*angle.slope);
+}
+
+
+#endif /* Dual_hpp */
@@ -0,0 +1,207 @@
+// File name: FastMath.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Approximate sin, cos and tan for evaluating trig terms. A function value only has to land
+// in the right cell of a Plane, so full double precision libm calls are usually more than needed.
+// Each kernel reduces its argument to [-pi/4, pi/4] around the nearest multiple of pi/2, then evaluates a
+// minimax polynomial. The kernels are inline and branch free, and each has a version for an array of
+// values whose loops can be vectorized.
+// Precision selects between the exact libm routines and two polynomial tiers:
+//   EXACT          - std::sin, std::cos, std::tan
+//   FLOAT_ACCURATE - degree 7/8 polynomials, error below float precision (~3e-9 absolute)
+//   CELL_ACCURATE  - degree 5/4 polynomials, error ~1e-5 absolute, far below any cell size
+// Last Changed: 10/19/26
+
+#ifndef FastMath_hpp
+#define FastMath_hpp
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+enum Precision { EXACT, FLOAT_ACCURATE, CELL_ACCURATE };
+
+// pi/2 split into three parts so that k*PIO2_1 and k*PIO2_2 are exact for |k| < 2^20
+static const double PIO2_1 = 1.57079632673412561417e+00;
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624871116645580e-21;
+static const double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+// beyond this, the three part reduction loses accuracy and the exact routine is used instead
+static const double REDUCTION_LIMIT = 1.0e6;
+
+// adding and then subtracting 1.5*2^52 rounds a double below 2^51 to the nearest integer, ties to even, as
+// nearbyint does. Unlike nearbyint, it is plain arithmetic, which can be vectorized
+static const double ROUNDING_SHIFT = 6755399441055744.0;
+
+// reduceQuarterPi helper function
+// pre: |value| < REDUCTION_LIMIT
+// post: returns r in [-pi/4, pi/4] such that value = r + quadrant*pi/2
+inline double reduceQuarterPi(double value, int &quadrant) {
+    double k = (value*TWO_OVER_PI + ROUNDING_SHIFT) - ROUNDING_SHIFT;
+    quadrant = int(k);
+    return ((value - k*PIO2_1) - k*PIO2_2) - k*PIO2_3;
+}
+
+// sinKernel helper function
+// pre: |r| <= pi/4
+// post: returns approximate sin(r)
+inline double sinKernel(double r, Precision precision) {
+    double z = r*r;
+    if (precision == CELL_ACCURATE) {
+        return r + r*z*(-1.6662833213759876e-01 + z*8.1529783825552100e-03);
+    }
+    return r + r*z*(-1.6666654611e-01 + z*(8.3321608736e-03 + z*-1.9515295891e-04));
+}
+
+// cosKernel helper function
+// pre: |r| <= pi/4
+// post: returns approximate cos(r)
+inline double cosKernel(double r, Precision precision) {
+    double z = r*r;
+    if (precision == CELL_ACCURATE) {
+        return 1.0 + z*(-4.997762637689819e-01 + z*4.048882171012578e-02);
+    }
+    return 1.0 - 0.5*z + z*z*(4.166664568298827e-02 + z*(-1.388731625493765e-03 + z*2.443315711809948e-05));
+}
+
+// fastSin
+// post: returns sin(value) to the given precision
+inline double fastSin(double value, Precision precision) {
+    if (precision == EXACT || !(std::fabs(value) < REDUCTION_LIMIT)) {
+        return std::sin(value);
+    }
+    int quadrant;
+    double r = reduceQuarterPi(value, quadrant);
+    double s = sinKernel(r, precision);
+    double c = cosKernel(r, precision);
+    double result = (quadrant & 1) ? c : s;
+    return (quadrant & 2) ? -result : result;
+}
+
+// fastCos
+// post: returns cos(value) to the given precision
+inline double fastCos(double value, Precision precision) {
+    if (precision == EXACT || !(std::fabs(value) < REDUCTION_LIMIT)) {
+        return std::cos(value);
+    }
+    int quadrant;
+    double r = reduceQuarterPi(value, quadrant);
+    double s = sinKernel(r, precision);
+    double c = cosKernel(r, precision);
+    double result = (quadrant & 1) ? s : c;
+    return ((quadrant + 1) & 2) ? -result : result;
+}
+
+// fastTan
+// post: returns tan(value) to the given precision
+inline double fastTan(double value, Precision precision) {
+    if (precision == EXACT || !(std::fabs(value) < REDUCTION_LIMIT)) {
+        return std::tan(value);
+    }
+    int quadrant;
+    double r = reduceQuarterPi(value, quadrant);
+    double s = sinKernel(r, precision);
+    double c = cosKernel(r, precision);
+    return (quadrant & 1) ? -c/s : s/c;
+}
+
+// selectQuadrant helper function
+// pre: odd and negate are 0 or 1
+// post: returns ifOdd if odd is 1, else ifEven, negated if negate is 1. The choice is made on the bits of
+// the two doubles, because the vectorizer won't turn a choice between computed doubles into a blend
+inline double selectQuadrant(uint64_t odd, uint64_t negate, double ifOdd, double ifEven) {
+    uint64_t oddBits, evenBits;
+    std::memcpy(&oddBits, &ifOdd, sizeof(double));
+    std::memcpy(&evenBits, &ifEven, sizeof(double));
+    uint64_t mask = uint64_t(0) - odd;
+    uint64_t bits = ((oddBits & mask) | (evenBits & ~mask)) ^ (negate << 63);
+    double result;
+    std::memcpy(&result, &bits, sizeof(double));
+    return result;
+}
+
+// reduceArray helper function
+// post: sets rs[i] to values[i] reduced to [-pi/4, pi/4] and quadrants[i] to its quadrant for i < count.
+// Values that aren't below REDUCTION_LIMIT are reduced as if they were 0. They are replaced in a loop of
+// their own, since the compiler turns the replaced values into a branch in the reducing loop
+inline void reduceArray(const double *values, double *rs, int *quadrants, size_t count) {
+    for (size_t index = 0; index < count; index++) {
+        rs[index] = std::fabs(values[index]) < REDUCTION_LIMIT ? values[index] : 0.0;
+    }
+    for (size_t index = 0; index < count; index++) {
+        rs[index] = reduceQuarterPi(rs[index], quadrants[index]);
+    }
+}
+
+// trigArray helper function
+// the values are reduced in one loop and the kernels evaluated in another, neither of which branches, so
+// both can be vectorized. Values too large to reduce are evaluated with exact instead
+// post: results[i] = the trig function named by ch ('s', 'c' or 't') of values[i] for i < count
+inline void trigArray(char ch, const double *values, double *results, size_t count, Precision precision,
+                      double (*exact)(double)) {
+    if (precision == EXACT) {
+        for (size_t index = 0; index < count; index++) {
+            results[index] = exact(values[index]);
+        }
+        return;
+    }
+    // values too large to reduce are found before results, which may be values, is written
+    std::vector<std::pair<size_t, double> > outOfRange;
+    for (size_t index = 0; index < count; index++) {
+        if (!(std::fabs(values[index]) < REDUCTION_LIMIT)) {
+            outOfRange.push_back(std::make_pair(index, exact(values[index])));
+        }
+    }
+    std::vector<double> rs(count);
+    std::vector<int> quadrants(count);
+    reduceArray(values, rs.data(), quadrants.data(), count);
+    // one loop per function, since the vectorizer won't unswitch a loop on ch
+    if (ch == 's') {
+        for (size_t index = 0; index < count; index++) {
+            double s = sinKernel(rs[index], precision);
+            double c = cosKernel(rs[index], precision);
+            results[index] = selectQuadrant(quadrants[index] & 1, (quadrants[index] >> 1) & 1, c, s);
+        }
+    }
+    else if (ch == 'c') {
+        for (size_t index = 0; index < count; index++) {
+            double s = sinKernel(rs[index], precision);
+            double c = cosKernel(rs[index], precision);
+            results[index] = selectQuadrant(quadrants[index] & 1, ((quadrants[index] + 1) >> 1) & 1, s, c);
+        }
+    }
+    else {
+        for (size_t index = 0; index < count; index++) {
+            double s = sinKernel(rs[index], precision);
+            double c = cosKernel(rs[index], precision);
+            results[index] = selectQuadrant(quadrants[index] & 1, quadrants[index] & 1, c/s, s/c);
+        }
+    }
+    for (size_t index = 0; index < outOfRange.size(); index++) {
+        results[outOfRange[index].first] = outOfRange[index].second;
+    }
+}
+
+// fastSin for an array
+// post: results[i] = fastSin(values[i], precision) for i < count. results may be values
+inline void fastSin(const double *values, double *results, size_t count, Precision precision) {
+    trigArray('s', values, results, count, precision, std::sin);
+}
+
+// fastCos for an array
+// post: results[i] = fastCos(values[i], precision) for i < count. results may be values
+inline void fastCos(const double *values, double *results, size_t count, Precision precision) {
+    trigArray('c', values, results, count, precision, std::cos);
+}
+
+// fastTan for an array
+// post: results[i] = fastTan(values[i], precision) for i < count. results may be values
+inline void fastTan(const double *values, double *results, size_t count, Precision precision) {
+    trigArray('t', values, results, count, precision, std::tan);
+}
+
+
+#endif /* FastMath_hpp */
@@ -0,0 +1,538 @@
+// File name: Parser.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of functions in "Parser.hpp"
+// Last Changed: 10/19/26
+
+#include "Parser.hpp"
+#include "Profiler.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+#include <cctype>
+using namespace std;
+
+
+// parsePolynomial
+// return value at a given xVal
+// post: return value at given xVal, with trig functions evaluated to the given precision. If profiler is
+// given, each term is timed as a node of it
+double parsePolynomial(vector<string> polySplit, double xVal, Precision precision, Profiler *profiler) {
+    double yVal = 0.0;
+    for (vector<string>::iterator iter = polySplit.begin(); iter < polySplit.end(); iter++) {
+        ProfileScope scope(profiler, *iter);
+        if (hasX(*iter)) {
+            if (hasPow(*iter)) {
+                yVal += getCoeff(*iter, xVal, precision, profiler)*pow(xVal, getExp(*iter));
+            }
+            else {
+                yVal += getCoeff(*iter, xVal, precision, profiler)*xVal;
+            }
+        }
+        // if function has power, but no X, check if trig function has power
+        else if (hasPow(*iter)) {
+            yVal += pow(getCoeff(*iter + "x", xVal, precision, profiler), getExp(*iter));
+        }
+        else {
+            // either trig function or constant
+            bool isTrig = true;
+            size_t count = 0;
+            while (count < (*iter).length() && !isalpha((*iter)[count])) {
+                count++;
+            }
+            if (count == (*iter).length()) {
+                // is a constant
+                yVal += stod(*iter);
+                isTrig = false;
+            }
+            if (isTrig) {
+                // else trig function
+                yVal += getCoeff(*iter + "x", xVal, precision, profiler);
+            }
+        }
+        
+    }
+    return yVal;
+}
+
+
+// split
+// splits polynomial by char + or -. Ignores polynomials within trig functions
+// post: returns pointer to string array containing each term of polynomial
+vector<string> split(string poly) {
+    vector<string> polySplit;
+    string temp = "";
+    bool isNeg = false;
+    
+    // the scans below stop at ')' and at the end of poly, so poly must be non-empty and its parentheses
+    // balanced before they start
+    if (poly.empty()) {
+        throw std::invalid_argument("empty function");
+    }
+    int depth = 0;
+    for (size_t count = 0; count < poly.length() && depth >= 0; count++) {
+        depth += int(poly[count] == '(') - int(poly[count] == ')');
+    }
+    if (depth != 0) {
+        throw std::invalid_argument("unbalanced parentheses in " + poly);
+    }
+    
+    // add first term
+    // we start at index 0 if the first term is positive, else we will start at index 1 and search
+    // for first occurence of '+' or '-'
+    size_t counter = size_t(poly[0] == '-');
+    if (counter) {
+        temp+= '-';
+    }
+    while (counter < poly.length() && poly[counter] != '+' && poly[counter] != '-') {
+        temp += poly[counter];
+        counter++;
+        
+        // ignore polynomials/constants in trig functions, because they are included in the trig term
+        if (poly[counter] == '(') {
+            while (poly[counter] != ')') {
+                temp += poly[counter];
+                counter++;
+            }
+            // add last ')'
+            temp += poly[counter];
+            counter++;
+        }
+        // if polynomial has one term
+        if (counter == poly.length()) {
+            polySplit.push_back(temp);
+            return polySplit;
+        }
+    }
+    polySplit.push_back(temp);
+    temp = "";
+    
+    // add middle terms
+    for (size_t count = counter + 1; count < poly.length(); count++) {
+        if (poly[count] == '+') {
+            if (isNeg) {
+                polySplit.push_back("-" + temp);
+            }
+            else {
+                polySplit.push_back(temp);
+            }
+            temp = "";
+        }
+        else if (poly[count] == '-') {
+            if (isNeg) {
+                polySplit.push_back("-" + temp);
+            }
+            else {
+                polySplit.push_back(temp);
+            }
+            isNeg = true;
+            temp = "";
+        }
+        else {
+            temp += poly[count];
+        }
+    }
+    
+    // add last term
+    if (isNeg) {
+        polySplit.push_back("-" + temp);
+    }
+    else {
+        polySplit.push_back(temp);
+    }
+    
+    // a sign with nothing after it, e.g. x+ or x++1, leaves an empty term
+    for (size_t count = 0; count < polySplit.size(); count++) {
+        if (polySplit[count] == "" || polySplit[count] == "-") {
+            throw std::invalid_argument("empty term in " + poly);
+        }
+    }
+    return polySplit;
+}
+
+
+// hasPow
+// post: returns whether str contains '^'. Does not include function inside a trig function
+bool hasPow(string term) {
+    size_t index = term.find(')');
+    if (index == -1) { index = 0; }
+    for (size_t count = index; count < term.length(); count++) {
+        if (term[count] == '^') {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// hasX
+// post: returns whether str contins 'x'; 'x' does not include occurrences within a trig function
+bool hasX(string term) {
+    size_t index = term.find(')');
+    if (index == -1) { index = 0; }
+    for (size_t count = index; count < term.length(); count++) {
+        if (term[count] == 'x') {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// getExp
+// pre: hasPow
+// post: returns exponent, does not include polynomial in trig function. Returns -1 if not found (should not occur)
+int getExp(string term) {
+    size_t index = term.find(')');
+    if (index == -1) { index = 0; }
+    for (size_t count = index; count < term.length(); count++) {
+        if (term[count] == '^') {
+            return int(count + 1);
+        }
+    }
+    return -1;
+}
+
+
+// getCoeff
+// pre: has coefficient before x-term. Coefficient can include trig functions
+// post: returns coefficient, or 1 if no coefficient before x term. Trig functions are evaluated to the
+// given precision. If profiler is given, a trig function is timed as a node of it
+double getCoeff(string term, double xVal, Precision precision, Profiler *profiler) {
+    // set index to end of trig function, if term contains one
+    int index = (int)term.find(')');
+    // if term contains no trig function, set it to zero
+    if (index == -1) { index = 0; }
+    
+    double coeff;
+    while (index < int(term.length()) && term[index] != 'x') {
+        index++;
+    }
+    if (index == int(term.length())) {
+        throw std::invalid_argument("no x after the coefficient in " + term);
+    }
+    if (term.substr(0, index) == "") {
+        return double(1);
+    }
+    else if (term.substr(0, index) == "-") {
+        return double(-1);
+    }
+    else {
+        // check if trig function
+        if (term.find('c') == -1 && term.find('s') == -1 && term.find('t') == -1) {
+            coeff = stod(term.substr(0, index));
+        }
+        else {
+            // check for correct trig function. term will be of the form const*trig_function(poly)
+            size_t trigIndex = 0;
+            // ignore coefficient
+            while (trigIndex < term.length() && !isalpha(term[trigIndex])) {
+                trigIndex++;
+            }
+            char ch = term[trigIndex];
+            trigIndex += 4;
+            // extract polynomial inside trig function
+            string trigPoly = term.substr(trigIndex, index - trigIndex - 1);
+            
+            // the trig function, e.g. sin(x^2), is a node of its own inside the term
+            ProfileScope scope(profiler, profiler != nullptr ? term.substr(trigIndex - 4, index - trigIndex + 4) : string());
+            switch (ch) {
+                case 's':
+                {
+                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal, precision, profiler)*fastSin(parsePolynomial(split(trigPoly), xVal, precision, profiler), precision);
+                    break;
+                }
+                case 'c':
+                {
+                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal, precision, profiler)*fastCos(parsePolynomial(split(trigPoly), xVal, precision, profiler), precision);
+                    break;
+                }
+                case 't':
+                {
+                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal, precision, profiler)*fastTan(parsePolynomial(split(trigPoly), xVal, precision, profiler), precision);
+                    break;
+                }
+                default :
+                    throw std::invalid_argument("unknown trig function in " + term);
+            }
+        }
+    }
+    return coeff;
+}
+
+
+// isConstant helper function
+// post: returns whether term has no letters, scanned as parsePolynomial scans it
+static bool isConstant(const string &term) {
+    size_t count = 0;
+    while (count < term.length() && !isalpha(term[count])) {
+        count++;
+    }
+    return count == term.length();
+}
+
+
+// getCoeff for a batch
+// same scan as getCoeff, with the argument of a trig function evaluated for the whole batch before the trig
+// function is applied to it
+// pre: has coefficient before x term, xs and coeffs each hold count doubles
+// post: coeffs[i] = getCoeff(term, xs[i], precision). If profiler is given, a trig function is timed across
+// the batch as a node of it
+static void getCoeff(const string &term, const double *xs, size_t count, double *coeffs, Precision precision,
+                     Profiler *profiler) {
+    int index = (int)term.find(')');
+    if (index == -1) { index = 0; }
+    
+    while (index < int(term.length()) && term[index] != 'x') {
+        index++;
+    }
+    if (index == int(term.length())) {
+        throw std::invalid_argument("no x after the coefficient in " + term);
+    }
+    double fixed;
+    if (term.substr(0, index) == "") {
+        fixed = 1;
+    }
+    else if (term.substr(0, index) == "-") {
+        fixed = -1;
+    }
+    else if (term.find('c') == -1 && term.find('s') == -1 && term.find('t') == -1) {
+        fixed = stod(term.substr(0, index));
+    }
+    else {
+        size_t trigIndex = 0;
+        while (trigIndex < term.length() && !isalpha(term[trigIndex])) {
+            trigIndex++;
+        }
+        char ch = term[trigIndex];
+        if (ch != 's' && ch != 'c' && ch != 't') {
+            throw std::invalid_argument("unknown trig function in " + term);
+        }
+        trigIndex += 4;
+        string trigPoly = term.substr(trigIndex, index - trigIndex - 1);
+        
+        // the trig function, e.g. sin(x^2), is a node of its own inside the term
+        ProfileScope scope(profiler, profiler != nullptr ? term.substr(trigIndex - 4, index - trigIndex + 4) : string());
+        vector<double> angles(count);
+        parsePolynomial(split(trigPoly), xs, count, angles.data(), precision, profiler);
+        switch (ch) {
+            case 's':
+                fastSin(angles.data(), angles.data(), count, precision);
+                break;
+            case 'c':
+                fastCos(angles.data(), angles.data(), count, precision);
+                break;
+            default :
+                fastTan(angles.data(), angles.data(), count, precision);
+                break;
+        }
+        getCoeff(term.substr(0, trigIndex - 4) + "x", xs, count, coeffs, precision, profiler);
+        for (size_t sample = 0; sample < count; sample++) {
+            coeffs[sample] *= angles[sample];
+        }
+        return;
+    }
+    for (size_t sample = 0; sample < count; sample++) {
+        coeffs[sample] = fixed;
+    }
+}
+
+
+// parsePolynomial for a batch
+// each term is classified once for the whole batch, and trig functions are evaluated over arrays
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const, xs and ys each hold count doubles
+// post: ys[i] = parsePolynomial(polySplit, xs[i], precision). If profiler is given, each term is timed
+// across the batch as a node of it
+void parsePolynomial(const vector<string> &polySplit, const double *xs, size_t count, double *ys, Precision precision,
+                     Profiler *profiler) {
+    for (size_t index = 0; index < count; index++) {
+        ys[index] = 0.0;
+    }
+    if (count == 0) {
+        return;
+    }
+    vector<double> coeffs(count);
+    for (vector<string>::const_iterator iter = polySplit.begin(); iter < polySplit.end(); iter++) {
+        ProfileScope scope(profiler, *iter);
+        // terms are read as parsePolynomial reads them: x terms, powers of trig functions, constants and trig
+        // functions
+        bool isXTerm = hasX(*iter);
+        bool isPow = hasPow(*iter);
+        if (!isXTerm && !isPow && isConstant(*iter)) {
+            double constant = stod(*iter);
+            for (size_t index = 0; index < count; index++) {
+                ys[index] += constant;
+            }
+            continue;
+        }
+        getCoeff(isXTerm ? *iter : *iter + "x", xs, count, coeffs.data(), precision, profiler);
+        if (isXTerm && isPow) {
+            int exponent = getExp(*iter);
+            for (size_t index = 0; index < count; index++) {
+                ys[index] += coeffs[index]*pow(xs[index], exponent);
+            }
+        }
+        else if (isXTerm) {
+            for (size_t index = 0; index < count; index++) {
+                ys[index] += coeffs[index]*xs[index];
+            }
+        }
+        else if (isPow) {
+            int exponent = getExp(*iter);
+            for (size_t index = 0; index < count; index++) {
+                ys[index] += pow(coeffs[index], exponent);
+            }
+        }
+        else {
+            for (size_t index = 0; index < count; index++) {
+                ys[index] += coeffs[index];
+            }
+        }
+    }
+}
+
+
+// getCoeffDual for a batch
+// same scan as getCoeff for a batch, with the argument of a trig function and its derivative evaluated for
+// the whole batch before the trig function is applied to them by the chain rule
+// pre: has coefficient before x term, xs, values and slopes each hold count doubles
+// post: values[i] and slopes[i] are the value and slope of getCoeffDual(term, xs[i], precision)
+static void getCoeffDual(const string &term, const double *xs, size_t count, double *values, double *slopes,
+                         Precision precision) {
+    int index = (int)term.find(')');
+    if (index == -1) { index = 0; }
+    
+    while (index < int(term.length()) && term[index] != 'x') {
+        index++;
+    }
+    if (index == int(term.length())) {
+        throw std::invalid_argument("no x after the coefficient in " + term);
+    }
+    double fixed;
+    if (term.substr(0, index) == "") {
+        fixed = 1;
+    }
+    else if (term.substr(0, index) == "-") {
+        fixed = -1;
+    }
+    else if (term.find('c') == -1 && term.find('s') == -1 && term.find('t') == -1) {
+        fixed = stod(term.substr(0, index));
+    }
+    else {
+        size_t trigIndex = 0;
+        while (trigIndex < term.length() && !isalpha(term[trigIndex])) {
+            trigIndex++;
+        }
+        char ch = term[trigIndex];
+        if (ch != 's' && ch != 'c' && ch != 't') {
+            throw std::invalid_argument("unknown trig function in " + term);
+        }
+        trigIndex += 4;
+        string trigPoly = term.substr(trigIndex, index - trigIndex - 1);
+        vector<double> angles(count), angleSlopes(count), trig(count), trigSlopes(count);
+        parsePolynomialDual(split(trigPoly), xs, count, angles.data(), angleSlopes.data(), precision);
+        switch (ch) {
+            case 's':
+                fastSin(angles.data(), trig.data(), count, precision);
+                fastCos(angles.data(), trigSlopes.data(), count, precision);
+                for (size_t sample = 0; sample < count; sample++) {
+                    trigSlopes[sample] = trigSlopes[sample]*angleSlopes[sample];
+                }
+                break;
+            case 'c':
+                fastCos(angles.data(), trig.data(), count, precision);
+                fastSin(angles.data(), trigSlopes.data(), count, precision);
+                for (size_t sample = 0; sample < count; sample++) {
+                    trigSlopes[sample] = -trigSlopes[sample]*angleSlopes[sample];
+                }
+                break;
+            default :
+                fastTan(angles.data(), trig.data(), count, precision);
+                for (size_t sample = 0; sample < count; sample++) {
+                    trigSlopes[sample] = (1 + trig[sample]*trig[sample])*angleSlopes[sample];
+                }
+                break;
+        }
+        // coefficient times trig function, by the product rule as Dual's operator* applies it
+        getCoeffDual(term.substr(0, trigIndex - 4) + "x", xs, count, values, slopes, precision);
+        for (size_t sample = 0; sample < count; sample++) {
+            slopes[sample] = slopes[sample]*trig[sample] + values[sample]*trigSlopes[sample];
+            values[sample] = values[sample]*trig[sample];
+        }
+        return;
+    }
+    for (size_t sample = 0; sample < count; sample++) {
+        values[sample] = fixed;
+        slopes[sample] = 0;
+    }
+}
+
+
+// parsePolynomialDual
+// forward mode automatic differentiation of parsePolynomial. Every term is read exactly as parsePolynomial
+// reads it, with Dual numbers in place of doubles
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const
+// post: returns f(xVal) as value and f'(xVal) as slope. value is the same as parsePolynomial returns
+Dual parsePolynomialDual(const vector<string> &polySplit, double xVal, Precision precision) {
+    Dual yVal;
+    parsePolynomialDual(polySplit, &xVal, 1, &yVal.value, &yVal.slope, precision);
+    return yVal;
+}
+
+
+// parsePolynomialDual for a batch
+// each term is classified once for the whole batch, and trig functions and their derivatives are evaluated
+// over arrays
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const, xs, values and slopes each hold count doubles
+// post: values[i] = f(xs[i]) and slopes[i] = f'(xs[i])
+void parsePolynomialDual(const vector<string> &polySplit, const double *xs, size_t count,
+                         double *values, double *slopes, Precision precision) {
+    for (size_t index = 0; index < count; index++) {
+        values[index] = 0.0;
+        slopes[index] = 0.0;
+    }
+    if (count == 0) {
+        return;
+    }
+    vector<double> coeffs(count), coeffSlopes(count);
+    for (vector<string>::const_iterator iter = polySplit.begin(); iter < polySplit.end(); iter++) {
+        // terms are read as parsePolynomial reads them: x terms, powers of trig functions, constants and trig
+        // functions
+        bool isXTerm = hasX(*iter);
+        bool isPow = hasPow(*iter);
+        int exponent = isPow ? getExp(*iter) : 1;
+        if (!isXTerm && !isPow && isConstant(*iter)) {
+            double constant = stod(*iter);
+            for (size_t index = 0; index < count; index++) {
+                values[index] += constant;
+            }
+            continue;
+        }
+        getCoeffDual(isXTerm ? *iter : *iter + "x", xs, count, coeffs.data(), coeffSlopes.data(), precision);
+        for (size_t index = 0; index < count; index++) {
+            Dual coeff(coeffs[index], coeffSlopes[index]);
+            Dual xVal(xs[index], 1);
+            Dual term;
+            if (isXTerm) {
+                term = isPow ? coeff*dualPow(xVal, exponent) : coeff*xVal;
+            }
+            else {
+                term = isPow ? dualPow(coeff, exponent) : coeff;
+            }
+            values[index] += term.value;
+            slopes[index] += term.slope;
+        }
+    }
+}
+
+
+// getCoeffDual
+// forward mode automatic differentiation of getCoeff
+// pre: has coefficient before x term
+// post: returns coefficient and its derivative at xVal. Throws invalid_argument if term holds a trig
+// function other than sin, cos or tan
+Dual getCoeffDual(string term, double xVal, Precision precision) {
+    Dual coeff;
+    getCoeffDual(term, &xVal, 1, &coeff.value, &coeff.slope, precision);
+    return coeff;
+}
@@ -0,0 +1,83 @@
+// File name: Parser.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Parser reads polynomial and trigonometric functions as strings. A function is split into
+// its terms with split, then evaluated at a given x with parsePolynomial. Trig functions take precedence
+// over polynomials, e.g. sin(x^2)5x^3+3
+// Last Changed: 10/19/26
+
+#ifndef Parser_hpp
+#define Parser_hpp
+
+#include <string>
+#include <vector>
+#include "FastMath.hpp"
+#include "Dual.hpp"
+
+class Profiler;
+
+// parsePolynomial
+// read polynomial as string and return value at a given xVal
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const
+// post: return value at given xVal, with trig functions evaluated to the given precision. If profiler is
+// given, each term is timed as a node of it
+double parsePolynomial(std::vector<std::string> polySplit, double xVal, Precision precision = EXACT,
+                       Profiler *profiler = nullptr);
+
+// parsePolynomial for a batch
+// each term is classified once for the whole batch, and trig functions are evaluated over arrays
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const, xs and ys each hold count doubles
+// post: ys[i] = parsePolynomial(polySplit, xs[i], precision). If profiler is given, each term is timed
+// across the batch as a node of it
+void parsePolynomial(const std::vector<std::string> &polySplit, const double *xs, size_t count, double *ys,
+                     Precision precision = EXACT, Profiler *profiler = nullptr);
+
+// split
+// splits string by given value ch
+// post: returns pointer to string array containing substrings of original string, split by ch. Throws
+// invalid_argument if poly is empty, its parentheses are unbalanced or a term is empty, e.g. x+
+std::vector<std::string> split(std::string poly);
+
+// hasPow
+// post: returns whether str contains '^'
+bool hasPow(std::string term);
+
+// hasX
+// post: returns whether str contins 'x'
+bool hasX(std::string term);
+
+// getExp
+// pre: term hasPow
+// post: returns exponent
+int getExp(std::string term);
+
+// getCoeff
+// pre: has coefficient before x term
+// post: returns coefficient, or 1 if no coefficient before x term. Trig functions are evaluated to the
+// given precision. Throws invalid_argument if term has no x after its coefficient or holds a trig
+// function other than sin, cos or tan. If profiler is given, a trig function is timed as a node of it
+double getCoeff(std::string term, double xVal, Precision precision = EXACT, Profiler *profiler = nullptr);
+
+// parsePolynomialDual
+// forward mode automatic differentiation of parsePolynomial. Every term is read exactly as parsePolynomial
+// reads it, with Dual numbers in place of doubles
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const
+// post: returns f(xVal) as value and f'(xVal) as slope. value is the same as parsePolynomial returns
+Dual parsePolynomialDual(const std::vector<std::string> &polySplit, double xVal, Precision precision = EXACT);
+
+// parsePolynomialDual for a batch
+// each term is classified once for the whole batch, and coefficients without trig functions are read once
+// pre: polynomial in the form Ax^n+Bx^n-1+...+const, xs, values and slopes each hold count doubles
+// post: values[i] = f(xs[i]) and slopes[i] = f'(xs[i])
+void parsePolynomialDual(const std::vector<std::string> &polySplit, const double *xs, size_t count,
+                         double *values, double *slopes, Precision precision = EXACT);
+
+// getCoeffDual
+// forward mode automatic differentiation of getCoeff
+// pre: has coefficient before x term
+// post: returns coefficient and its derivative at xVal. Throws invalid_argument if term has no x after its
+// coefficient or holds a trig function other than sin, cos or tan
+Dual getCoeffDual(std::string term, double xVal, Precision precision = EXACT);
+
+
+#endif /* Parser_hpp */
@@ -2,7 +2,7 @@
 // Author: John Kim
 // Email: john.j.kim@vanderbilt.edu
 // Description: Definitions of classes in "Plane.hpp"
-// Last Changed: 05/15/16
+// Last Changed: 10/19/26
 
 #include "Plane.hpp"
 #include <string>
@@ -12,9 +12,15 @@
 #include <fstream>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
 
 using namespace std;
 
+// number of points addPoints maps to indices before filling them
+static const size_t ADD_BATCH_SIZE = 256;
+
 
 // default ctor
 // creates a 0 by 0 dimensional Plane
@@ -24,7 +30,13 @@ Plane::Plane() :
 x_length(0),
 y_length(0),
 X_SAMPLES_PER_UNIT(1),
-Y_SAMPLES_PER_UNIT(1)
+Y_SAMPLES_PER_UNIT(1),
+xIndices(0),
+yIndices(0),
+xScale(1),
+yScale(1),
+xOffset(0),
+yOffset(0)
 {
     myPlane = nullptr;
 }
@@ -40,17 +52,21 @@ y_length(y),
 X_SAMPLES_PER_UNIT(x_samples),
 Y_SAMPLES_PER_UNIT(y_samples),
 xIndices(2*int(x*x_samples) + 1),
-yIndices(2*int(y*y_samples) + 1)
+yIndices(2*int(y*y_samples) + 1),
+xScale(double(x_samples)),
+yScale(double(y_samples)),
+xOffset(int(x*x_samples)),
+yOffset(int(y*y_samples))
 {
     
     // create two dimensional myPlane
     // Since x and y denote the length of the positive x and y axes, myPlane must be of size
     // 2x+1 and 2y+1 to account for the negative x and y axes and the origin
-    myPlane = new Point*[yIndices];
-    for (size_t yCount = 0; yCount < yIndices; yCount++) {
-        myPlane[yCount] = new Point[xIndices];
-        for (size_t xCount = 0; xCount < xIndices; xCount++) {
-            myPlane[yCount][xCount] = *new Point(toCor(xCount, 'x'), toCor(yCount, 'y'));
+    allocate();
+    size_t columns = size_t(xIndices), rows = size_t(yIndices);
+    for (size_t yCount = 0; yCount < rows; yCount++) {
+        for (size_t xCount = 0; xCount < columns; xCount++) {
+            myPlane[yCount][xCount] = Point(toCor(xCount, 'x'), toCor(yCount, 'y'));
         }
     }
     
@@ -61,17 +77,25 @@ yIndices(2*int(y*y_samples) + 1)
 // copies Plane rhs to new obj
 Plane::Plane(const Plane &rhs) :
 x_length(rhs.x_length),
-y_length(rhs.y_length)
+y_length(rhs.y_length),
+X_SAMPLES_PER_UNIT(rhs.X_SAMPLES_PER_UNIT),
+Y_SAMPLES_PER_UNIT(rhs.Y_SAMPLES_PER_UNIT),
+xIndices(rhs.xIndices),
+yIndices(rhs.yIndices),
+xScale(rhs.xScale),
+yScale(rhs.yScale),
+xOffset(rhs.xOffset),
+yOffset(rhs.yOffset)
 {
     // if rhs is empty, set myPlane to nullptr
     if (rhs.myPlane == nullptr) {
         myPlane = nullptr;
     }
     else {
-        myPlane = new Point*[yIndices];
-        for (size_t yCor = 0; yCor < yIndices; yCor++) {
-            myPlane[yCor] = new Point[xIndices];
-            for (size_t xCor = 0; xCor < xIndices; xCor++) {
+        allocate();
+        size_t columns = size_t(xIndices), rows = size_t(yIndices);
+        for (size_t yCor = 0; yCor < rows; yCor++) {
+            for (size_t xCor = 0; xCor < columns; xCor++) {
                 // copy all Points from rhs.myPlane to myPlane
                 myPlane[yCor][xCor] = rhs.myPlane[yCor][xCor];
             }
@@ -82,14 +106,28 @@ y_length(rhs.y_length)
 
 // destructor
 Plane::~Plane() {
-    for (size_t yCount = 0; yCount < yIndices; yCount++) {
-        delete[] myPlane[yCount];
+    if (myPlane != nullptr) {
+        delete[] myPlane[0];
     }
     delete[] myPlane;
     myPlane = nullptr;
 }
 
 
+// allocate helper function
+// pre: xIndices and yIndices are set
+// post: myPlane holds yIndices row pointers into one contiguous block of xIndices*yIndices Points,
+// followed by a single sink Point that absorbs clipped writes from addPoints
+void Plane::allocate() {
+    myPlane = new Point*[yIndices];
+    size_t columns = size_t(xIndices), rows = size_t(yIndices);
+    Point *cells = new Point[columns*rows + 1];
+    for (size_t yCount = 0; yCount < rows; yCount++) {
+        myPlane[yCount] = cells + yCount*columns;
+    }
+}
+
+
 // assignment operator
 // assigns rhs to this Plane
 const Plane& Plane::operator= (const Plane& rhs) {
@@ -102,6 +140,12 @@ const Plane& Plane::operator= (const Plane& rhs) {
         std::swap(y_length, temp.y_length);
         std::swap(yIndices, temp.yIndices);
         std::swap(xIndices, temp.xIndices);
+        std::swap(X_SAMPLES_PER_UNIT, temp.X_SAMPLES_PER_UNIT);
+        std::swap(Y_SAMPLES_PER_UNIT, temp.Y_SAMPLES_PER_UNIT);
+        std::swap(xScale, temp.xScale);
+        std::swap(yScale, temp.yScale);
+        std::swap(xOffset, temp.xOffset);
+        std::swap(yOffset, temp.yOffset);
     }
     return *this;
 }
@@ -111,7 +155,7 @@ const Plane& Plane::operator= (const Plane& rhs) {
 // pre: Point is within dimensions of Plane
 // post: returns true if (x,y) contains a Point, else false
 bool Plane::isEmpty(int x, int y) {
-    if (myPlane[toIndex(y, 'y')][toIndex(x, 'x')].getCh() == ' ') {
+    if (myPlane[toIndex<'y'>(y)][toIndex<'x'>(x)].getCh() == ' ') {
         return true;
     }
     return false;
@@ -122,7 +166,7 @@ bool Plane::isEmpty(int x, int y) {
 // pre: Point is within dimensions of Plane
 // post: returns true if Point is filled, else false
 bool Plane::isEmpty(Point point) {
-    if (myPlane[toIndex(point.getY(), 'y')][toIndex(point.getX(), 'x')].getCh() == ' ') {
+    if (myPlane[toIndex<'y'>(point.getY())][toIndex<'x'>(point.getX())].getCh() == ' ') {
         return true;
     }
     return false;
@@ -136,15 +180,87 @@ void Plane::addPoint(double x, double y) {
         // do nothing
     }
     else {
-        myPlane[toIndex(y, 'y')][toIndex(x, 'x')].fillPoint();
+        myPlane[toIndex<'y'>(y)][toIndex<'x'>(x)].fillPoint();
+    }
+}
+
+
+// insideMask helper function
+// pre: index is not -0.0, limitBits holds the bits of a positive double
+// post: returns all ones if 0 <= index < that double, else 0, also for NaN. Non-negative doubles are
+// ordered like their bits, and negative ones have the top bit set, so the test is integer arithmetic,
+// which the vectorizer accepts where it won't turn a compare of doubles into a mask
+static inline uint64_t insideMask(double index, uint64_t limitBits) {
+    uint64_t bits;
+    std::memcpy(&bits, &index, sizeof(double));
+    return uint64_t(int64_t((bits - limitBits) & ~bits) >> 63);
+}
+
+
+// addPoints
+// batch version of addPoint for the sampling loop. Coordinates are mapped to indices in one pass,
+// points outside the Plane are clipped without branching, then all cells are filled together
+// pre: xs and ys each hold count coordinates
+// post: every (xs[i], ys[i]) within the Plane is added to it, drawn with glyph if one is given
+void Plane::addPoints(const double *xs, const double *ys, size_t count, char glyph) {
+    if (myPlane == nullptr) {
+        return;
+    }
+    Point *cells = myPlane[0];
+    const size_t sink = size_t(xIndices)*size_t(yIndices);
+    double flat[ADD_BATCH_SIZE];
+    
+    // the limits of the clipping test and the sink index, as bits
+    double columns = double(xIndices), rows = double(yIndices), sinkIndex = double(sink);
+    uint64_t columnBits, rowBits, sinkBits;
+    std::memcpy(&columnBits, &columns, sizeof(double));
+    std::memcpy(&rowBits, &rows, sizeof(double));
+    std::memcpy(&sinkBits, &sinkIndex, sizeof(double));
+    
+    for (size_t start = 0; start < count; start += ADD_BATCH_SIZE) {
+        size_t batch = std::min(ADD_BATCH_SIZE, count - start);
+        
+        // map every coordinate to a flat index. Indices stay doubles, which hold any index of a Plane
+        // exactly, so values far outside the Plane (or NaN) never reach an int conversion. Rounding,
+        // clipping and choosing the index are all arithmetic, so the loop is vectorized
+        for (size_t pointCount = 0; pointCount < batch; pointCount++) {
+            double xIndex = toColumn(xs[start + pointCount], xScale, xOffset);
+            double yIndex = toRow(ys[start + pointCount], yScale, yOffset);
+            uint64_t inside = insideMask(xIndex, columnBits) & insideMask(yIndex, rowBits);
+            // clipped points are sent to the sink Point instead of being skipped
+            double index = yIndex*columns + xIndex;
+            uint64_t indexBits;
+            std::memcpy(&indexBits, &index, sizeof(double));
+            indexBits = (indexBits & inside) | (sinkBits & ~inside);
+            std::memcpy(&flat[pointCount], &indexBits, sizeof(double));
+        }
+        
+        if (glyph == '\0') {
+            for (size_t pointCount = 0; pointCount < batch; pointCount++) {
+                cells[size_t(flat[pointCount])].fillPoint();
+            }
+        }
+        else {
+            for (size_t pointCount = 0; pointCount < batch; pointCount++) {
+                cells[size_t(flat[pointCount])].fillPoint(glyph);
+            }
+        }
     }
 }
 
 
+// fillCell
+// pre: 0 <= xIndex < xIndices, 0 <= yIndex < yIndices
+// post: Point at column xIndex and row yIndex is filled
+void Plane::fillCell(int xIndex, int yIndex) {
+    myPlane[yIndex][xIndex].fillPoint();
+}
+
+
 // getPoint
 // post: returns Point at x and y. If Point doesn't exist, returns Point(-1, -1)
 Point Plane::getPoint(int x, int y) {
-    return myPlane[toIndex(y, 'y')][toIndex(x, 'x')];
+    return myPlane[toIndex<'y'>(y)][toIndex<'x'>(x)];
 }
 
 
@@ -176,36 +292,55 @@ size_t Plane::getYSample() const {
 }
 
 
+// getXIndices
+// post: returns number of columns in Plane, 2*x_length*X_SAMPLES_PER_UNIT + 1
+int Plane::getXIndices() const {
+    return xIndices;
+}
+
+
+// getYIndices
+// post: returns number of rows in Plane, 2*y_length*Y_SAMPLES_PER_UNIT + 1
+int Plane::getYIndices() const {
+    return yIndices;
+}
+
+
+// getRaster
+// post: returns every cell's char, row by row from the top of the Plane, without borders or newlines
+string Plane::getRaster() const {
+    size_t columns = size_t(xIndices), rows = size_t(yIndices);
+    string raster(columns*rows, ' ');
+    for (size_t yCol = 0; yCol < rows; yCol++) {
+        for (size_t xCol = 0; xCol < columns; xCol++) {
+            raster[yCol*columns + xCol] = myPlane[yCol][xCol].getCh();
+        }
+    }
+    return raster;
+}
+
+
+// printRaster
+// post: writes what getRaster returns to outfile, one row at a time
+void Plane::printRaster(ostream &outfile) const {
+    size_t columns = size_t(xIndices), rows = size_t(yIndices);
+    string row(columns, ' ');
+    for (size_t yCol = 0; yCol < rows; yCol++) {
+        for (size_t xCol = 0; xCol < columns; xCol++) {
+            row[xCol] = myPlane[yCol][xCol].getCh();
+        }
+        outfile.write(row.data(), row.size());
+    }
+}
+
+
 // print for polynomials
 // post: prints plane
 void Plane::print(string filename, string polynomial) {
     ofstream outfile;
     outfile.open(filename, ios::ate);
-    
-    // formatting...
-    outfile << "f(x) = " << polynomial << endl;
-    outfile << "X SCALE: 1 char = " << 1/double(X_SAMPLES_PER_UNIT) << "units." << endl;
-    outfile << "Y SCALE: 1 char = " << 1/double(Y_SAMPLES_PER_UNIT) << "units." << endl;
-    outfile << "Window: -" << x_length << " < x < " << x_length << " | -" << y_length << " < y < " << y_length << endl << endl;
-    
-    outfile << "╔";
-    for (size_t topBorder = 0; topBorder < xIndices; topBorder++) {
-        outfile << "═";
-    }
-    outfile << "╗\n";
-    for (size_t yCol = 0; yCol < yIndices; yCol++) {
-        outfile << "║";
-        for (size_t xCol = 0; xCol < xIndices; xCol++) {
-            outfile << myPlane[yCol][xCol].getCh();
-        }
-        outfile << "║" << endl;
-    }
-    outfile << "╚";
-    for (size_t bottomBorder = 0; bottomBorder < xIndices; bottomBorder++) {
-        outfile << "═";
-    }
-    outfile << "╝";
-    
+    printHeader(outfile, polynomial);
+    printRows(outfile, 0, yIndices);
     outfile.close();
 }
 
@@ -215,40 +350,88 @@ void Plane::print(string filename, string polynomial) {
 void Plane::print(string filename, string xParam, string yParam, double tStart, double tEnd) {
     ofstream outfile;
     outfile.open(filename, ios::ate);
-    
+    printHeader(outfile, xParam, yParam, tStart, tEnd);
+    printRows(outfile, 0, yIndices);
+    outfile.close();
+}
+
+
+// printHeader for polynomials
+// post: writes the function, scale and window lines print starts with
+void Plane::printHeader(ostream &outfile, string polynomial) const {
+    printPlaneHeader(outfile, polynomial, x_length, y_length, X_SAMPLES_PER_UNIT, Y_SAMPLES_PER_UNIT);
+}
+
+
+// printHeader for parametric
+// post: writes the function, scale and window lines print starts with
+void Plane::printHeader(ostream &outfile, string xParam, string yParam, double tStart, double tEnd) const {
+    printPlaneHeader(outfile, xParam, yParam, tStart, tEnd, x_length, y_length, X_SAMPLES_PER_UNIT, Y_SAMPLES_PER_UNIT);
+}
+
+
+// printPlaneHeader for polynomials
+// post: writes the function, scale and window lines a printed plane starts with. Plane and SparsePlane
+// both write their headers with it, so their files are the same
+void printPlaneHeader(ostream &outfile, const string &polynomial, size_t x_length, size_t y_length,
+                      size_t xSamples, size_t ySamples) {
+    // formatting...
+    outfile << "f(x) = " << polynomial << endl;
+    outfile << "X SCALE: 1 char = " << 1/double(xSamples) << "units." << endl;
+    outfile << "Y SCALE: 1 char = " << 1/double(ySamples) << "units." << endl;
+    outfile << "Window: -" << x_length << " < x < " << x_length << " | -" << y_length << " < y < " << y_length << endl << endl;
+}
+
+
+// printPlaneHeader for parametric
+// post: writes the functions, scale, window and range lines a printed plane starts with
+void printPlaneHeader(ostream &outfile, const string &xParam, const string &yParam, double tStart,
+                      double tEnd, size_t x_length, size_t y_length, size_t xSamples, size_t ySamples) {
     // formatting...
     outfile << "a(x) = " << xParam << endl;
     outfile << "b(x) = " << yParam << endl;
-    outfile << "X SCALE: 1 char = " << 1/double(X_SAMPLES_PER_UNIT) << "units." << endl;
-    outfile << "Y SCALE: 1 char = " << 1/double(Y_SAMPLES_PER_UNIT) << "units." << endl;
+    outfile << "X SCALE: 1 char = " << 1/double(xSamples) << "units." << endl;
+    outfile << "Y SCALE: 1 char = " << 1/double(ySamples) << "units." << endl;
     outfile << "Window: -" << x_length << " < a < " << x_length << " | -" << y_length << " < b < " << y_length << endl;
     outfile << tStart << " < x < " << tEnd << endl << endl;
-    
-    outfile << "╔";
-    for (size_t topBorder = 0; topBorder < xIndices; topBorder++) {
-        outfile << "═";
+}
+
+
+// printRows
+// pre: 0 <= firstRow <= lastRow <= yIndices
+// post: writes rows firstRow up to lastRow between side borders, preceded by the top border if firstRow
+// is 0 and followed by the bottom border if lastRow is yIndices
+void Plane::printRows(ostream &outfile, int firstRow, int lastRow) const {
+    size_t columns = size_t(xIndices);
+    if (firstRow == 0) {
+        outfile << "╔";
+        for (size_t topBorder = 0; topBorder < columns; topBorder++) {
+            outfile << "═";
+        }
+        outfile << "╗\n";
     }
-    outfile << "╗\n";
-    for (size_t yCol = 0; yCol < yIndices; yCol++) {
+    for (size_t yCol = size_t(firstRow); yCol < size_t(lastRow); yCol++) {
         outfile << "║";
-        for (size_t xCol = 0; xCol < xIndices; xCol++) {
+        for (size_t xCol = 0; xCol < columns; xCol++) {
             outfile << myPlane[yCol][xCol].getCh();
         }
         outfile << "║" << endl;
     }
-    outfile << "╚";
-    for (size_t bottomBorder = 0; bottomBorder < xIndices; bottomBorder++) {
-        outfile << "═";
+    if (lastRow == yIndices) {
+        outfile << "╚";
+        for (size_t bottomBorder = 0; bottomBorder < columns; bottomBorder++) {
+            outfile << "═";
+        }
+        outfile << "╝";
     }
-    outfile << "╝";
-    
-    outfile.close();
 }
 
 
 // inPlane overloaded function
 bool Plane::inPlane(double x, double y) {
-    if (toIndex(x, 'x') < 0 || toIndex(x, 'x') > xIndices || toIndex(y, 'y') < 0 || toIndex(y, 'y') > yIndices) {
+    int xIndex = toIndex<'x'>(x);
+    int yIndex = toIndex<'y'>(y);
+    if (xIndex < 0 || xIndex >= xIndices || yIndex < 0 || yIndex >= yIndices) {
         return false;
     }
     return true;
@@ -279,13 +462,31 @@ int Plane::toIndex(double cor, char axis) {
         throw std::invalid_argument("axis must be either 'x' or 'y'");
     }
     else if (axis == 'x') {
-        return int(std::round(X_SAMPLES_PER_UNIT*cor)) + int(std::round(X_SAMPLES_PER_UNIT*x_length));
+        return toIndex<'x'>(cor);
     }
     else {
-        return int(std::round(Y_SAMPLES_PER_UNIT*y_length)) - int(std::round(Y_SAMPLES_PER_UNIT*cor));
+        return toIndex<'y'>(cor);
     }
 }
 
 
+// toIndex specialized for the x axis
+// pre: value within Plane
+// post: returns index value equivalent
+template <>
+int Plane::toIndex<'x'>(double cor) const {
+    return int(toColumn(cor, xScale, xOffset));
+}
+
+
+// toIndex specialized for the y axis
+// pre: value within Plane
+// post: returns index value equivalent
+template <>
+int Plane::toIndex<'y'>(double cor) const {
+    return int(toRow(cor, yScale, yOffset));
+}
+
+
 
 
@@ -5,14 +5,17 @@
 // x and y, representing the ordered pair (x, y). An empty point is represented by a ' ', while a
 // filled point is represented by a '*'. x_length and y_length are the lengths of the positive x and y axes,
 // while xDim and yDim represent the window size of the graph, equivalently (2*x_length + 1) or (2*y_length + 1)
-// Last Changed: 05/15/16
+// Last Changed: 10/19/26
 
 #ifndef Plane_hpp
 #define Plane_hpp
 
 #include <stdio.h>
 #include <string>
+#include <iosfwd>
+#include <cmath>
 #include "Point.hpp"
+#include "FastMath.hpp"
 
 // Plane recreates a Cartesian plane. The origin is at (0,0). It can hold negative and positive integers for
 // x and y (x, y). An empty point is represented by a ' ', while a filled point is represented by a *
@@ -27,6 +30,16 @@ private:
     size_t Y_SAMPLES_PER_UNIT;
     int xIndices;
     int yIndices;
+    
+    // per-axis scale and offset used by toIndex, precomputed so index mapping is one multiply and add
+    double xScale, yScale;
+    int xOffset, yOffset;
+    
+    // allocate helper function
+    // pre: xIndices and yIndices are set
+    // post: myPlane holds yIndices row pointers into one contiguous block of xIndices*yIndices Points,
+    // followed by a single sink Point that absorbs clipped writes from addPoints
+    void allocate();
 public:
     
     // default ctor
@@ -71,6 +84,18 @@ public:
     // post: Point added to Plane, if it doesn't already exist
     void addPoint(Point point);
     
+    // addPoints
+    // batch version of addPoint for the sampling loop. Coordinates are mapped to indices in one pass,
+    // points outside the Plane are clipped without branching, then all cells are filled together
+    // pre: xs and ys each hold count coordinates
+    // post: every (xs[i], ys[i]) within the Plane is added to it, drawn with glyph if one is given
+    void addPoints(const double *xs, const double *ys, size_t count, char glyph = '\0');
+    
+    // fillCell
+    // pre: 0 <= xIndex < xIndices, 0 <= yIndex < yIndices
+    // post: Point at column xIndex and row yIndex is filled
+    void fillCell(int xIndex, int yIndex);
+    
     // getPoint
     // post: returns Point at x and y. If Point doesn't exist, returns Point(-1, -1)
     Point getPoint(int x, int y);
@@ -96,6 +121,22 @@ public:
     // post: returns Y_SAMPLES_PER_UNIT
     size_t getYSample() const;
     
+    // getXIndices
+    // post: returns number of columns in Plane, 2*x_length*X_SAMPLES_PER_UNIT + 1
+    int getXIndices() const;
+    
+    // getYIndices
+    // post: returns number of rows in Plane, 2*y_length*Y_SAMPLES_PER_UNIT + 1
+    int getYIndices() const;
+    
+    // getRaster
+    // post: returns every cell's char, row by row from the top of the Plane, without borders or newlines
+    std::string getRaster() const;
+    
+    // printRaster
+    // post: writes what getRaster returns to outfile, one row at a time
+    void printRaster(std::ostream &outfile) const;
+    
     // print for polynomials
     // post: prints plane
     void print(std::string filename, std::string polynomial);
@@ -104,6 +145,20 @@ public:
     // post: prints plane
     void print(std::string filename, std::string xParam, std::string yParam, double tStart, double tEnd);
     
+    // printHeader for polynomials
+    // post: writes the function, scale and window lines print starts with
+    void printHeader(std::ostream &outfile, std::string polynomial) const;
+    
+    // printHeader for parametric
+    // post: writes the function, scale and window lines print starts with
+    void printHeader(std::ostream &outfile, std::string xParam, std::string yParam, double tStart, double tEnd) const;
+    
+    // printRows
+    // pre: 0 <= firstRow <= lastRow <= yIndices
+    // post: writes rows firstRow up to lastRow between side borders, preceded by the top border if firstRow
+    // is 0 and followed by the bottom border if lastRow is yIndices
+    void printRows(std::ostream &outfile, int firstRow, int lastRow) const;
+    
     // inPlane overloaded function
     bool inPlane(double x, double y);
     
@@ -117,7 +172,53 @@ public:
     // post: returns index value equivalent
     int toIndex(double cor, char axis);
     
+    // toIndex specialized on axis at compile time
+    // pre: value within Plane, axis is either 'x' or 'y'
+    // post: returns index value equivalent
+    template <char axis>
+    int toIndex(double cor) const;
+    
 };
 
+template <> int Plane::toIndex<'x'>(double cor) const;
+template <> int Plane::toIndex<'y'>(double cor) const;
+
+// roundHalfAway
+// post: returns value rounded to the nearest integer, halves away from zero, as std::round does for
+// |value| < 2^51. Larger values and infinities stay far outside any Plane, and NaN stays NaN. Unlike
+// std::round, a libm call on baseline x86-64, it is plain arithmetic, so loops calling it can be
+// vectorized: ROUNDING_SHIFT rounds |value| with ties to even, and a tie it rounded down is moved up
+inline double roundHalfAway(double value) {
+    double magnitude = std::fabs(value);
+    double rounded = (magnitude + ROUNDING_SHIFT) - ROUNDING_SHIFT;
+    rounded += (magnitude - rounded == 0.5) ? 1.0 : 0.0;
+    return std::copysign(rounded, value);
+}
+
+// toColumn
+// post: returns the column x falls in, for a window mapped by xScale and xOffset. Kept a double so a
+// coordinate far outside the window, or NaN, can be clipped before it reaches an int conversion
+inline double toColumn(double x, double xScale, int xOffset) {
+    return roundHalfAway(xScale*x) + xOffset;
+}
+
+// toRow
+// post: returns the row y falls in, counted from the top, for a window mapped by yScale and yOffset. Kept
+// a double for the same reason as toColumn
+inline double toRow(double y, double yScale, int yOffset) {
+    return yOffset - roundHalfAway(yScale*y);
+}
+
+// printPlaneHeader for polynomials
+// post: writes the function, scale and window lines a printed plane starts with. Plane and SparsePlane
+// both write their headers with it, so their files are the same
+void printPlaneHeader(std::ostream &outfile, const std::string &polynomial, size_t x_length, size_t y_length,
+                      size_t xSamples, size_t ySamples);
+
+// printPlaneHeader for parametric
+// post: writes the functions, scale, window and range lines a printed plane starts with
+void printPlaneHeader(std::ostream &outfile, const std::string &xParam, const std::string &yParam, double tStart,
+                      double tEnd, size_t x_length, size_t y_length, size_t xSamples, size_t ySamples);
+
 
 #endif /* Plane_hpp */
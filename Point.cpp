@@ -46,6 +46,12 @@ void Point::fillPoint()
     }
 }
 
+// fillPoint overloaded function
+// post: ch set to glyph
+void Point::fillPoint(char glyph) {
+    ch = glyph;
+}
+
 // emptyPoint
 // post: ch set to ' '
 void Point::emptyPoint() {
@@ -28,6 +28,10 @@ public :
     // post: ch set to x if at origin, else *
     void fillPoint();
     
+    // fillPoint overloaded function
+    // post: ch set to glyph
+    void fillPoint(char glyph);
+    
     // emptyPoint
     // post: ch set to ' '
     void emptyPoint();
@@ -0,0 +1,158 @@
+// File name: Profiler.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of classes in "Profiler.hpp"
+// Last Changed: 10/19/26
+
+#include "Profiler.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+
+// alternate ctor
+// post: Profiler exists with only a root node named rootName
+Profiler::Profiler(const string &rootName) {
+    Node root;
+    root.name = rootName;
+    root.parent = 0;
+    root.calls = 0;
+    root.seconds = 0;
+    nodes.push_back(root);
+}
+
+
+// enter
+// post: the child of the current node named name is entered and its clock started. The child is
+// created the first time it is entered
+void Profiler::enter(const string &name) {
+    size_t parent = stack.empty() ? 0 : stack.back();
+    size_t child = 0;
+    
+    // a node has few children, so they are searched in order
+    const vector<size_t> &children = nodes[parent].children;
+    for (size_t index = 0; index < children.size(); index++) {
+        if (nodes[children[index]].name == name) {
+            child = children[index];
+            break;
+        }
+    }
+    if (child == 0) {
+        Node node;
+        node.name = name;
+        node.parent = parent;
+        node.calls = 0;
+        node.seconds = 0;
+        child = nodes.size();
+        nodes.push_back(node);
+        nodes[parent].children.push_back(child);
+    }
+    stack.push_back(child);
+    starts.push_back(Clock::now());
+}
+
+
+// exit
+// pre: a node has been entered and not exited
+// post: time since the node was entered is added to it, and its parent is the current node again
+void Profiler::exit() {
+    Clock::time_point end = Clock::now();
+    Node &node = nodes[stack.back()];
+    node.calls++;
+    node.seconds += chrono::duration<double>(end - starts.back()).count();
+    stack.pop_back();
+    starts.pop_back();
+}
+
+
+// getNodeCount
+// post: returns number of nodes, not counting the root
+size_t Profiler::getNodeCount() const {
+    return nodes.size() - 1;
+}
+
+
+// getTotalSeconds
+// post: returns the time spent in nodes entered directly from the root
+double Profiler::getTotalSeconds() const {
+    double seconds = 0;
+    for (size_t index = 0; index < nodes[0].children.size(); index++) {
+        seconds += nodes[nodes[0].children[index]].seconds;
+    }
+    return seconds;
+}
+
+
+// getPath helper function
+// post: returns the names of node and its parents below the root, from the top down, separated by
+// separator
+string Profiler::getPath(size_t node, const string &separator) const {
+    string path = nodes[node].name;
+    for (node = nodes[node].parent; node != 0; node = nodes[node].parent) {
+        path = nodes[node].name + separator + path;
+    }
+    return path;
+}
+
+
+// getSelfSeconds helper function
+// post: returns the time of node not spent in its children
+double Profiler::getSelfSeconds(size_t node) const {
+    double seconds = node == 0 ? getTotalSeconds() : nodes[node].seconds;
+    for (size_t index = 0; index < nodes[node].children.size(); index++) {
+        seconds -= nodes[nodes[node].children[index]].seconds;
+    }
+    return std::max(seconds, 0.0);
+}
+
+
+// printReport
+// post: writes every node ranked by self time, with its share of the total, total time and calls
+void Profiler::printReport(ostream &outfile) const {
+    vector<size_t> ranked;
+    for (size_t node = 1; node < nodes.size(); node++) {
+        ranked.push_back(node);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [this](size_t lhs, size_t rhs) {
+        return getSelfSeconds(lhs) > getSelfSeconds(rhs);
+    });
+    double total = getTotalSeconds();
+    ios::fmtflags flags = outfile.flags();
+    streamsize precision = outfile.precision();
+    
+    // formatting...
+    outfile << "Profile of " << nodes[0].name << endl;
+    outfile << "Total: " << fixed << setprecision(3) << total*1e3 << " ms" << endl << endl;
+    outfile << setw(8) << "self %" << setw(12) << "self ms" << setw(12) << "total ms" << setw(12) << "calls"
+            << setw(12) << "ns/call" << "  node" << endl;
+    for (size_t index = 0; index < ranked.size(); index++) {
+        const Node &node = nodes[ranked[index]];
+        double self = getSelfSeconds(ranked[index]);
+        outfile << setw(8) << setprecision(1) << (total > 0 ? 100*self/total : 0.0)
+                << setw(12) << setprecision(3) << self*1e3
+                << setw(12) << node.seconds*1e3
+                << setw(12) << node.calls
+                << setw(12) << setprecision(0) << (node.calls != 0 ? node.seconds*1e9/double(node.calls) : 0.0)
+                << "  " << getPath(ranked[index], " > ") << endl;
+    }
+    outfile.flags(flags);
+    outfile.precision(precision);
+}
+
+
+// printCollapsed
+// post: writes one line per node, its path from the root separated by ';' followed by its self time in
+// microseconds, as flame graph tools read them
+void Profiler::printCollapsed(ostream &outfile) const {
+    for (size_t node = 1; node < nodes.size(); node++) {
+        long long micros = std::llround(getSelfSeconds(node)*1e6);
+        if (micros > 0) {
+            outfile << nodes[0].name << ";" << getPath(node, ";") << " " << micros << "\n";
+        }
+    }
+}
@@ -0,0 +1,114 @@
+// File name: Profiler.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Profiler attributes time and calls to the parts of a function as it is graphed. Each term
+// parsePolynomial reads, and each trig function getCoeff reads inside a term, is a node. Nodes are nested
+// as the parser nests them, so a term inside sin(...) is a child of the sin node. Stages that aren't
+// part of the function, like rasterizing, are nodes too. A node's self time is its time minus its
+// children's. The report ranks nodes by self time, and the collapsed stacks can be read by flame graph
+// tools. A Profiler is used by one thread at a time.
+// Last Changed: 10/19/26
+
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iosfwd>
+
+class Profiler {
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    struct Node {
+        std::string name;
+        size_t parent;
+        std::vector<size_t> children;
+        size_t calls;
+        double seconds;
+    };
+    
+    // node 0 is the root, which is never timed
+    std::vector<Node> nodes;
+    
+    // nodes entered and not yet exited, innermost last, and when each was entered
+    std::vector<size_t> stack;
+    std::vector<Clock::time_point> starts;
+    
+    // getPath helper function
+    // post: returns the names of node and its parents below the root, from the top down, separated by
+    // separator
+    std::string getPath(size_t node, const std::string &separator) const;
+    
+    // getSelfSeconds helper function
+    // post: returns the time of node not spent in its children
+    double getSelfSeconds(size_t node) const;
+    
+public:
+    
+    // alternate ctor
+    // post: Profiler exists with only a root node named rootName
+    Profiler(const std::string &rootName);
+    
+    // enter
+    // post: the child of the current node named name is entered and its clock started. The child is
+    // created the first time it is entered
+    void enter(const std::string &name);
+    
+    // exit
+    // pre: a node has been entered and not exited
+    // post: time since the node was entered is added to it, and its parent is the current node again
+    void exit();
+    
+    // getNodeCount
+    // post: returns number of nodes, not counting the root
+    size_t getNodeCount() const;
+    
+    // getTotalSeconds
+    // post: returns the time spent in nodes entered directly from the root
+    double getTotalSeconds() const;
+    
+    // printReport
+    // post: writes every node ranked by self time, with its share of the total, total time and calls
+    void printReport(std::ostream &outfile) const;
+    
+    // printCollapsed
+    // post: writes one line per node, its path from the root separated by ';' followed by its self time in
+    // microseconds, as flame graph tools read them
+    void printCollapsed(std::ostream &outfile) const;
+};
+
+// ProfileScope enters a node of a Profiler when it is created and exits it when it is destroyed, so the
+// node is exited even if an exception is thrown. A null Profiler is ignored
+class ProfileScope {
+private:
+    Profiler *profiler;
+    
+public:
+    
+    // alternate ctor
+    // post: node named name is entered, if profiler isn't null
+    ProfileScope(Profiler *profiler, const std::string &name) :
+    profiler(profiler)
+    {
+        if (profiler != nullptr) {
+            profiler->enter(name);
+        }
+    }
+    
+    // destructor
+    ~ProfileScope() {
+        if (profiler != nullptr) {
+            profiler->exit();
+        }
+    }
+    
+private:
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator= (const ProfileScope&);
+};
+
+
+#endif /* Profiler_hpp */
@@ -0,0 +1,235 @@
+// File name: Pyramid.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of classes in "Pyramid.hpp"
+// Last Changed: 10/19/26
+
+#include "Pyramid.hpp"
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+#include <exception>
+
+using namespace std;
+
+
+// parentIndex helper function
+// pre: offset is the index of the origin in the finer level, and is even
+// post: returns the index in the next coarser level of the cell containing fine cell index. Matches
+// Plane::toIndex, which rounds halves away from zero
+static int parentIndex(int index, int offset) {
+    int fromOrigin = index - offset;
+    int half = fromOrigin >= 0 ? (fromOrigin + 1)/2 : -((1 - fromOrigin)/2);
+    return offset/2 + half;
+}
+
+
+// runThreads helper function
+// post: calls task(first, last) on threadCount threads, splitting [0, count) into contiguous ranges. If a
+// call throws, the first exception thrown by a range is rethrown here once every thread has finished,
+// rather than ending the program on the thread that threw it
+static void runThreads(size_t count, size_t threadCount, const function<void(size_t, size_t)> &task) {
+    vector<thread> workers;
+    size_t chunk = (count + threadCount - 1)/threadCount;
+    vector<exception_ptr> errors(chunk == 0 ? 0 : (count + chunk - 1)/chunk);
+    for (size_t first = 0; first < count; first += chunk) {
+        size_t worker = workers.size();
+        size_t last = std::min(count, first + chunk);
+        workers.push_back(thread([&, worker, first, last]() {
+            try {
+                task(first, last);
+            }
+            catch (...) {
+                errors[worker] = current_exception();
+            }
+        }));
+    }
+    for (size_t worker = 0; worker < workers.size(); worker++) {
+        workers[worker].join();
+    }
+    for (size_t worker = 0; worker < errors.size(); worker++) {
+        if (errors[worker]) {
+            rethrow_exception(errors[worker]);
+        }
+    }
+}
+
+
+// alternate ctor
+// creates an empty pyramid over the window x by y, whose finest level has x_samples and y_samples
+// samples per unit. Throws invalid_argument if the samples per unit can't be halved levels - 1 times
+// pre: levels >= 1
+// post: pyramid exists with no function sampled
+ZoomPyramid::ZoomPyramid(size_t x, size_t y, size_t x_samples, size_t y_samples, size_t levels) :
+x_length(x),
+y_length(y),
+levelCount(levels)
+{
+    if (levels == 0 || x_samples % (size_t(1) << (levels - 1)) != 0 || y_samples % (size_t(1) << (levels - 1)) != 0) {
+        throw std::invalid_argument("samples per unit must be divisible by 2^(levels - 1)");
+    }
+    for (size_t level = 0; level < levels; level++) {
+        xSamples.push_back(x_samples >> level);
+        ySamples.push_back(y_samples >> level);
+        xIndices.push_back(2*int(x*xSamples[level]) + 1);
+        yIndices.push_back(2*int(y*ySamples[level]) + 1);
+    }
+    this->levels.resize(levels);
+}
+
+
+// build
+// pre: curve evaluates the function to graph
+// post: curve is sampled across the window at the finest samples per unit, and every level is built.
+// Sampling and coarsening are split across the hardware threads. Anything curve throws is rethrown here
+void ZoomPyramid::build(const function<double(double)> &curve) {
+    size_t threadCount = std::max(1u, thread::hardware_concurrency());
+    
+    // x values are stepped exactly like the interactive program steps them, so the finest level matches a
+    // Plane graphed at the same window and samples per unit
+    vector<double> xVals;
+    for (double xVal = -double(x_length); xVal <= double(x_length); xVal = xVal + 1/double(xSamples[0])) {
+        xVals.push_back(xVal);
+    }
+    vector<double> yVals(xVals.size());
+    runThreads(xVals.size(), threadCount, [&](size_t first, size_t last) {
+        for (size_t index = first; index < last; index++) {
+            yVals[index] = curve(xVals[index]);
+        }
+    });
+    
+    // plot the samples into the finest level
+    vector<char> &finest = levels[0];
+    finest.assign(size_t(xIndices[0])*size_t(yIndices[0]), 0);
+    double xScale = double(xSamples[0]), yScale = double(ySamples[0]);
+    int xOffset = int(x_length*xSamples[0]), yOffset = int(y_length*ySamples[0]);
+    for (size_t index = 0; index < xVals.size(); index++) {
+        double xIndex = toColumn(xVals[index], xScale, xOffset);
+        double yIndex = toRow(yVals[index], yScale, yOffset);
+        if (xIndex >= 0 && xIndex < xIndices[0] && yIndex >= 0 && yIndex < yIndices[0]) {
+            finest[size_t(yIndex)*size_t(xIndices[0]) + size_t(xIndex)] = 1;
+        }
+    }
+    
+    for (size_t level = 1; level < levelCount; level++) {
+        coarsen(level, threadCount);
+    }
+}
+
+
+// coarsen helper function
+// pre: level > 0 and the level below it has been built
+// post: level is built from the level below it, threadCount rows at a time
+void ZoomPyramid::coarsen(size_t level, size_t threadCount) {
+    const vector<char> &fine = levels[level - 1];
+    vector<char> &coarse = levels[level];
+    int fineColumns = xIndices[level - 1];
+    int fineRows = yIndices[level - 1];
+    int columns = xIndices[level];
+    int rows = yIndices[level];
+    coarse.assign(size_t(columns)*size_t(rows), 0);
+    
+    // children of each coarse column and row are a contiguous range of fine columns and rows
+    vector<int> firstColumn(columns, fineColumns), lastColumn(columns, 0);
+    for (int column = 0; column < fineColumns; column++) {
+        int parent = parentIndex(column, int(x_length*xSamples[level - 1]));
+        firstColumn[parent] = std::min(firstColumn[parent], column);
+        lastColumn[parent] = std::max(lastColumn[parent], column + 1);
+    }
+    vector<int> firstRow(rows, fineRows), lastRow(rows, 0);
+    for (int row = 0; row < fineRows; row++) {
+        int parent = parentIndex(row, int(y_length*ySamples[level - 1]));
+        firstRow[parent] = std::min(firstRow[parent], row);
+        lastRow[parent] = std::max(lastRow[parent], row + 1);
+    }
+    
+    runThreads(size_t(rows), threadCount, [&](size_t first, size_t last) {
+        for (size_t row = first; row < last; row++) {
+            for (int column = 0; column < columns; column++) {
+                char filled = 0;
+                for (int fineRow = firstRow[row]; fineRow < lastRow[row]; fineRow++) {
+                    const char *cells = &fine[size_t(fineRow)*size_t(fineColumns)];
+                    for (int fineColumn = firstColumn[column]; fineColumn < lastColumn[column]; fineColumn++) {
+                        filled |= cells[fineColumn];
+                    }
+                }
+                coarse[row*size_t(columns) + size_t(column)] = filled;
+            }
+        }
+    });
+}
+
+
+// getLevel
+// post: returns the level with x_samples and y_samples samples per unit, or -1 if there is none
+int ZoomPyramid::getLevel(size_t x_samples, size_t y_samples) const {
+    for (size_t level = 0; level < levelCount; level++) {
+        if (xSamples[level] == x_samples && ySamples[level] == y_samples) {
+            return int(level);
+        }
+    }
+    return -1;
+}
+
+
+// crop
+// creates a Plane of the window x by y at x_samples and y_samples samples per
+// unit. Throws invalid_argument if no level has those samples per unit or the window doesn't fit
+// pre: build has been called
+// post: returns Plane cropped from the center of the matching level
+Plane ZoomPyramid::crop(size_t x, size_t y, size_t x_samples, size_t y_samples) const {
+    int level = getLevel(x_samples, y_samples);
+    if (level == -1) {
+        throw std::invalid_argument("samples per unit must match a level of the pyramid");
+    }
+    if (x > x_length || y > y_length) {
+        throw std::invalid_argument("window must fit in the window of the pyramid");
+    }
+    Plane graph(x, y, x_samples, y_samples);
+    const vector<char> &cells = levels[level];
+    size_t columnOffset = (x_length - x)*x_samples;
+    size_t rowOffset = (y_length - y)*y_samples;
+    for (int row = 0; row < graph.getYIndices(); row++) {
+        const char *source = &cells[(rowOffset + row)*size_t(xIndices[level]) + columnOffset];
+        for (int column = 0; column < graph.getXIndices(); column++) {
+            if (source[column]) {
+                graph.fillCell(column, row);
+            }
+        }
+    }
+    return graph;
+}
+
+
+// getLevelCount
+// post: returns number of levels
+size_t ZoomPyramid::getLevelCount() const {
+    return levelCount;
+}
+
+
+// getXSample
+// post: returns samples per unit along x of level
+size_t ZoomPyramid::getXSample(size_t level) const {
+    return xSamples[level];
+}
+
+
+// getYSample
+// post: returns samples per unit along y of level
+size_t ZoomPyramid::getYSample(size_t level) const {
+    return ySamples[level];
+}
+
+
+// getMemoryUsage
+// post: returns bytes held by the rasters of every level
+size_t ZoomPyramid::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (size_t level = 0; level < levelCount; level++) {
+        bytes += levels[level].capacity();
+    }
+    return bytes;
+}
@@ -0,0 +1,82 @@
+// File name: Pyramid.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: ZoomPyramid serves zoomed views of a function without sampling it again. The function is
+// sampled once into the finest level, a raster of the full window at the highest samples per unit. Each
+// coarser level halves the samples per unit on both axes, and a cell is filled if any of its child cells
+// in the level below is filled. Children are the cells whose centers map to the parent cell exactly as
+// Plane maps coordinates to cells. Any window that fits in the full window, at the samples per unit of a
+// level, is then served by cropping that level, in time proportional to the cells served.
+// Last Changed: 10/19/26
+
+#ifndef Pyramid_hpp
+#define Pyramid_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Plane.hpp"
+
+class ZoomPyramid {
+private:
+    size_t x_length, y_length;
+    size_t levelCount;
+    
+    // samples per unit and size of each level, finest first
+    std::vector<size_t> xSamples, ySamples;
+    std::vector<int> xIndices, yIndices;
+    
+    // one filled flag per cell of each level, row by row from the top
+    std::vector<std::vector<char> > levels;
+    
+    // coarsen helper function
+    // pre: level > 0 and the level below it has been built
+    // post: level is built from the level below it, threadCount rows at a time
+    void coarsen(size_t level, size_t threadCount);
+    
+public:
+    
+    // alternate ctor
+    // creates an empty pyramid over the window x by y, whose finest level has x_samples and y_samples
+    // samples per unit. Throws invalid_argument if the samples per unit can't be halved levels - 1 times
+    // pre: levels >= 1
+    // post: pyramid exists with no function sampled
+    ZoomPyramid(size_t x, size_t y, size_t x_samples, size_t y_samples, size_t levels);
+    
+    // build
+    // pre: curve evaluates the function to graph
+    // post: curve is sampled across the window at the finest samples per unit, and every level is built.
+    // Sampling and coarsening are split across the hardware threads. Anything curve throws is rethrown here
+    void build(const std::function<double(double)> &curve);
+    
+    // getLevel
+    // post: returns the level with x_samples and y_samples samples per unit, or -1 if there is none
+    int getLevel(size_t x_samples, size_t y_samples) const;
+    
+    // crop
+    // creates a Plane of the window x by y at x_samples and y_samples samples per
+    // unit. Throws invalid_argument if no level has those samples per unit or the window doesn't fit
+    // pre: build has been called
+    // post: returns Plane cropped from the center of the matching level
+    Plane crop(size_t x, size_t y, size_t x_samples, size_t y_samples) const;
+    
+    // getLevelCount
+    // post: returns number of levels
+    size_t getLevelCount() const;
+    
+    // getXSample
+    // post: returns samples per unit along x of level
+    size_t getXSample(size_t level) const;
+    
+    // getYSample
+    // post: returns samples per unit along y of level
+    size_t getYSample(size_t level) const;
+    
+    // getMemoryUsage
+    // post: returns bytes held by the rasters of every level
+    size_t getMemoryUsage() const;
+};
+
+
+#endif /* Pyramid_hpp */
@@ -0,0 +1,374 @@
+// File name: Render.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of functions in "Render.hpp"
+// Last Changed: 10/19/26
+
+#include "Render.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <streambuf>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include "Plane.hpp"
+#include "SparsePlane.hpp"
+#include "Parser.hpp"
+
+using namespace std;
+
+// number of points sampled and added to the plane at a time
+static const size_t RENDER_BATCH_SIZE = 1024;
+
+// sets xs[i] and ys[i] to the point sampled at ts[i], for count values of t
+typedef function<void(const double*, size_t, double*, double*)> BatchEvaluator;
+
+// BufferStreambuf writes straight into a caller's buffer, so rendering to a buffer makes no copies.
+// Chars that don't fit are counted but dropped, so size is the full length of what was written
+class BufferStreambuf : public streambuf {
+private:
+    size_t dropped;
+    
+protected:
+    int_type overflow(int_type ch) {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            dropped++;
+        }
+        return traits_type::not_eof(ch);
+    }
+    
+    streamsize xsputn(const char *text, streamsize count) {
+        streamsize copied = std::min<streamsize>(count, epptr() - pptr());
+        if (copied > 0) {
+            memcpy(pptr(), text, size_t(copied));
+        }
+        for (streamsize left = copied; left > 0; left -= INT_MAX) {
+            pbump(int(std::min<streamsize>(left, INT_MAX)));
+        }
+        dropped += size_t(count - copied);
+        return count;
+    }
+    
+public:
+    BufferStreambuf(char *buffer, size_t capacity) :
+    dropped(0)
+    {
+        setp(buffer, buffer + capacity);
+    }
+    
+    // size
+    // post: returns number of chars written, including those that didn't fit
+    size_t size() const {
+        return size_t(pptr() - pbase()) + dropped;
+    }
+};
+
+
+// default ctor
+// post: a 0 by 0 window at 1 sample per unit, exact and without the derivative
+RenderParams::RenderParams() :
+x_length(0),
+y_length(0),
+xSamples(1),
+ySamples(1),
+precision(EXACT),
+derivative(false)
+{
+    // nothing to do
+}
+
+
+// default ctor
+// post: no tiles were used
+RenderStats::RenderStats() :
+tileCount(0),
+memoryUsage(0)
+{
+    // nothing to do
+}
+
+
+// isValid helper function
+// post: returns whether the window has samples along both axes
+static bool isValid(const RenderParams &params) {
+    return params.xSamples != 0 && params.ySamples != 0;
+}
+
+
+// sampleInto helper function
+// post: samples t = tStart, tStart + tStep, ... up to tEnd a batch at a time and adds the points to graph,
+// passing each batch to onSamples if given
+template <class PlaneType>
+static void sampleInto(PlaneType &graph, double tStart, double tEnd, double tStep, const BatchEvaluator &evaluate,
+                       const SampleCallback &onSamples) {
+    vector<double> ts, xs(RENDER_BATCH_SIZE), ys(RENDER_BATCH_SIZE);
+    ts.reserve(RENDER_BATCH_SIZE);
+    for (double tVal = tStart; tVal <= tEnd; tVal = tVal + tStep) {
+        ts.push_back(tVal);
+        if (ts.size() == RENDER_BATCH_SIZE || !(tVal + tStep <= tEnd)) {
+            evaluate(ts.data(), ts.size(), xs.data(), ys.data());
+            if (onSamples) {
+                onSamples(xs.data(), ys.data(), ts.size());
+            }
+            graph.addPoints(xs.data(), ys.data(), ts.size());
+            ts.clear();
+        }
+    }
+}
+
+
+// sampleWithDerivative helper function
+// post: samples f and f' at x = -x_length, ... up to x_length with one Dual number sweep per batch. Adds
+// (x, f'(x)) with DERIVATIVE_GLYPH, then (x, f(x)), to graph. Every sample is in its own column, so f is
+// drawn over f' where they meet. Each batch of (x, f(x)) is passed to onSamples if given
+template <class PlaneType>
+static void sampleWithDerivative(PlaneType &graph, const vector<string> &polySplit, const RenderParams &params,
+                                 const SampleCallback &onSamples) {
+    double tStep = 1/double(params.xSamples);
+    double tEnd = double(params.x_length);
+    vector<double> xs, values(RENDER_BATCH_SIZE), slopes(RENDER_BATCH_SIZE);
+    xs.reserve(RENDER_BATCH_SIZE);
+    for (double tVal = -double(params.x_length); tVal <= tEnd; tVal = tVal + tStep) {
+        xs.push_back(tVal);
+        if (xs.size() == RENDER_BATCH_SIZE || !(tVal + tStep <= tEnd)) {
+            parsePolynomialDual(polySplit, xs.data(), xs.size(), values.data(), slopes.data(), params.precision);
+            if (onSamples) {
+                onSamples(xs.data(), values.data(), xs.size());
+            }
+            graph.addPoints(xs.data(), slopes.data(), xs.size(), DERIVATIVE_GLYPH);
+            graph.addPoints(xs.data(), values.data(), xs.size());
+            xs.clear();
+        }
+    }
+}
+
+
+// sampleCurve helper function
+// post: samples into graph, with f' as well if derivativeOf is given
+template <class PlaneType>
+static void sampleCurve(PlaneType &graph, const RenderParams &params, double tStart, double tEnd,
+                        const BatchEvaluator &evaluate, const SampleCallback &onSamples,
+                        const vector<string> *derivativeOf) {
+    if (derivativeOf != nullptr) {
+        sampleWithDerivative(graph, *derivativeOf, params, onSamples);
+    }
+    else {
+        sampleInto(graph, tStart, tEnd, 1/double(params.xSamples), evaluate, onSamples);
+    }
+}
+
+
+// renderFramed helper function
+// pre: outfile already holds the header
+// post: samples into graph and writes its rows and borders to outfile
+template <class PlaneType>
+static void renderFramed(PlaneType &graph, ostream &outfile, const RenderParams &params, double tStart, double tEnd,
+                         const BatchEvaluator &evaluate, const SampleCallback &onSamples,
+                         const vector<string> *derivativeOf) {
+    sampleCurve(graph, params, tStart, tEnd, evaluate, onSamples, derivativeOf);
+    graph.printRows(outfile, 0, graph.getYIndices());
+}
+
+
+// render helper function
+// pre: evaluate has been checked at tStart, printHeader writes the header of graph to a stream. derivativeOf
+// is the function split into terms if its derivative is drawn, else nullptr
+// post: writes the graph in format to outfile. Framed windows of more than SPARSE_CELL_LIMIT cells are
+// graphed on a SparsePlane, whose size is written to stats if given. Rasters are as large as the window
+// anyway, so they always use a Plane
+static void render(const RenderParams &params, RenderFormat format, ostream &outfile, double tStart, double tEnd,
+                   const BatchEvaluator &evaluate, const SampleCallback &onSamples,
+                   const function<void(ostream&, const Plane&)> &printHeader,
+                   const function<void(ostream&, const SparsePlane&)> &printSparseHeader,
+                   const vector<string> *derivativeOf, RenderStats *stats) {
+    size_t cellCount = size_t(2*params.x_length*params.xSamples + 1)*size_t(2*params.y_length*params.ySamples + 1);
+    if (format == RASTER) {
+        Plane graph(params.x_length, params.y_length, params.xSamples, params.ySamples);
+        sampleCurve(graph, params, tStart, tEnd, evaluate, onSamples, derivativeOf);
+        graph.printRaster(outfile);
+    }
+    else if (cellCount > SPARSE_CELL_LIMIT) {
+        SparsePlane graph(params.x_length, params.y_length, params.xSamples, params.ySamples);
+        printSparseHeader(outfile, graph);
+        renderFramed(graph, outfile, params, tStart, tEnd, evaluate, onSamples, derivativeOf);
+        if (stats != nullptr) {
+            stats->tileCount = graph.getTileCount();
+            stats->memoryUsage = graph.getMemoryUsage();
+        }
+    }
+    else {
+        Plane graph(params.x_length, params.y_length, params.xSamples, params.ySamples);
+        printHeader(outfile, graph);
+        renderFramed(graph, outfile, params, tStart, tEnd, evaluate, onSamples, derivativeOf);
+    }
+}
+
+
+// profileInto helper function
+// post: samples f(x) = polySplit into graph a batch at a time, as sampleInto does, and writes its rows and
+// borders to outfile, timing each stage
+template <class PlaneType>
+static void profileInto(PlaneType &graph, const vector<string> &polySplit, const RenderParams &params,
+                        ostream &outfile, Profiler &profiler) {
+    double tStep = 1/double(params.xSamples);
+    double tEnd = double(params.x_length);
+    vector<double> xs, ys(RENDER_BATCH_SIZE);
+    xs.reserve(RENDER_BATCH_SIZE);
+    for (double tVal = -double(params.x_length); tVal <= tEnd; tVal = tVal + tStep) {
+        xs.push_back(tVal);
+        if (xs.size() == RENDER_BATCH_SIZE || !(tVal + tStep <= tEnd)) {
+            {
+                ProfileScope scope(&profiler, "[evaluate]");
+                parsePolynomial(polySplit, xs.data(), xs.size(), ys.data(), params.precision, &profiler);
+            }
+            ProfileScope scope(&profiler, "[rasterize]");
+            graph.addPoints(xs.data(), ys.data(), xs.size());
+            xs.clear();
+        }
+    }
+    ProfileScope scope(&profiler, "[write]");
+    graph.printRows(outfile, 0, graph.getYIndices());
+}
+
+
+// renderFunction
+// graphs f(x) = polynomial across the window
+// pre: polynomial in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or polynomial can't be parsed. If stats is given,
+// it is set to the size of the SparsePlane used
+RenderStatus renderFunction(const string &polynomial, const RenderParams &params, RenderFormat format,
+                            ostream &outfile, const SampleCallback &onSamples, RenderStats *stats) {
+    if (!isValid(params)) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    vector<string> polySplit;
+    Precision precision = params.precision;
+    double tStart = -double(params.x_length);
+    
+    // malformed functions are rejected here, by split or a trial evaluation, before anything is written
+    try {
+        polySplit = split(polynomial);
+        parsePolynomial(polySplit, tStart, precision);
+    }
+    catch (std::exception &error) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    BatchEvaluator evaluate = [&](const double *ts, size_t count, double *xs, double *ys) {
+        std::copy(ts, ts + count, xs);
+        parsePolynomial(polySplit, ts, count, ys, precision);
+    };
+    render(params, format, outfile, tStart, double(params.x_length), evaluate, onSamples,
+           [&](ostream &out, const Plane &graph) { graph.printHeader(out, polynomial); },
+           [&](ostream &out, const SparsePlane &graph) { graph.printHeader(out, polynomial); },
+           params.derivative ? &polySplit : nullptr, stats);
+    return RENDER_OK;
+}
+
+
+// renderFunction for a buffer
+// post: writes the graph to buffer, which holds capacity chars, and sets written to the length of the
+// graph. Returns RENDER_BUFFER_TOO_SMALL if the graph is longer than capacity, in which case buffer holds
+// the first capacity chars of it and the call can be repeated with a buffer of written chars
+RenderStatus renderFunction(const string &polynomial, const RenderParams &params, RenderFormat format,
+                            char *buffer, size_t capacity, size_t &written, const SampleCallback &onSamples) {
+    BufferStreambuf target(buffer, capacity);
+    ostream outfile(&target);
+    RenderStatus status = renderFunction(polynomial, params, format, outfile, onSamples);
+    written = target.size();
+    if (status == RENDER_OK && written > capacity) {
+        return RENDER_BUFFER_TOO_SMALL;
+    }
+    return status;
+}
+
+
+// renderParametric
+// graphs (a(x), b(x)) = (xParam, yParam) for tStart <= x <= tEnd
+// pre: xParam and yParam in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or either function can't be parsed. If stats is
+// given, it is set to the size of the SparsePlane used
+RenderStatus renderParametric(const string &xParam, const string &yParam, double tStart, double tEnd,
+                              const RenderParams &params, RenderFormat format, ostream &outfile,
+                              const SampleCallback &onSamples, RenderStats *stats) {
+    if (!isValid(params)) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    vector<string> xParaSplit, yParaSplit;
+    Precision precision = params.precision;
+    try {
+        xParaSplit = split(xParam);
+        yParaSplit = split(yParam);
+        parsePolynomial(xParaSplit, tStart, precision);
+        parsePolynomial(yParaSplit, tStart, precision);
+    }
+    catch (std::exception &error) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    BatchEvaluator evaluate = [&](const double *ts, size_t count, double *xs, double *ys) {
+        parsePolynomial(xParaSplit, ts, count, xs, precision);
+        parsePolynomial(yParaSplit, ts, count, ys, precision);
+    };
+    render(params, format, outfile, tStart, tEnd, evaluate, onSamples,
+           [&](ostream &out, const Plane &graph) { graph.printHeader(out, xParam, yParam, tStart, tEnd); },
+           [&](ostream &out, const SparsePlane &graph) { graph.printHeader(out, xParam, yParam, tStart, tEnd); },
+           nullptr, stats);
+    return RENDER_OK;
+}
+
+
+// renderParametric for a buffer
+// post: writes the graph to buffer, which holds capacity chars, and sets written to the length of the
+// graph. Returns RENDER_BUFFER_TOO_SMALL if the graph is longer than capacity, in which case buffer holds
+// the first capacity chars of it
+RenderStatus renderParametric(const string &xParam, const string &yParam, double tStart, double tEnd,
+                              const RenderParams &params, RenderFormat format, char *buffer, size_t capacity,
+                              size_t &written, const SampleCallback &onSamples) {
+    BufferStreambuf target(buffer, capacity);
+    ostream outfile(&target);
+    RenderStatus status = renderParametric(xParam, yParam, tStart, tEnd, params, format, outfile, onSamples);
+    written = target.size();
+    if (status == RENDER_OK && written > capacity) {
+        return RENDER_BUFFER_TOO_SMALL;
+    }
+    return status;
+}
+
+
+// profileFunction
+// graphs f(x) = polynomial as renderFunction does in FRAMED format, a batch at a time on this thread, while
+// profiler times evaluating each batch ("[evaluate]"), every term and trig function inside it across the
+// batch, adding points to the plane ("[rasterize]") and writing the plane ("[write]"). derivative is ignored
+// pre: polynomial in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or polynomial can't be parsed
+RenderStatus profileFunction(const string &polynomial, const RenderParams &params, ostream &outfile,
+                             Profiler &profiler) {
+    if (!isValid(params)) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    vector<string> polySplit;
+    try {
+        polySplit = split(polynomial);
+        parsePolynomial(polySplit, -double(params.x_length), params.precision);
+    }
+    catch (std::exception &error) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    size_t cellCount = size_t(2*params.x_length*params.xSamples + 1)*size_t(2*params.y_length*params.ySamples + 1);
+    if (cellCount > SPARSE_CELL_LIMIT) {
+        SparsePlane graph(params.x_length, params.y_length, params.xSamples, params.ySamples);
+        graph.printHeader(outfile, polynomial);
+        profileInto(graph, polySplit, params, outfile, profiler);
+    }
+    else {
+        Plane graph(params.x_length, params.y_length, params.xSamples, params.ySamples);
+        graph.printHeader(outfile, polynomial);
+        profileInto(graph, polySplit, params, outfile, profiler);
+    }
+    return RENDER_OK;
+}
@@ -0,0 +1,115 @@
+// File name: Render.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Render is the library interface to the graphing calculator. It parses a function, samples
+// it and writes the graph to a caller's stream or buffer, in the same framed format as Plane::print or
+// as a bare raster of cell chars. Every call works only on its own Plane and parsed terms, so calls don't
+// share state and may run at the same time on any number of threads. Nothing is read from or written to
+// files or the console. RenderC.h wraps these functions for C callers.
+// Last Changed: 10/19/26
+
+#ifndef Render_hpp
+#define Render_hpp
+
+#include <stdio.h>
+#include <string>
+#include <ostream>
+#include <functional>
+#include "FastMath.hpp"
+#include "Profiler.hpp"
+
+// windows with more cells than this are graphed on a SparsePlane when framed
+static const size_t SPARSE_CELL_LIMIT = 4000000;
+
+// glyph f'(x) is drawn with when a function is rendered with its derivative
+static const char DERIVATIVE_GLYPH = '\'';
+
+// window and sampling of a render
+struct RenderParams {
+    // lengths of the positive x and y axes, in units
+    size_t x_length, y_length;
+    
+    // samples per unit along x and y
+    size_t xSamples, ySamples;
+    
+    // precision of trig functions
+    Precision precision;
+    
+    // also draw f'(x) with DERIVATIVE_GLYPH, under f(x) where the two meet. Only used by renderFunction
+    bool derivative;
+    
+    // default ctor
+    // post: a 0 by 0 window at 1 sample per unit, exact and without the derivative
+    RenderParams();
+};
+
+// RASTER writes xIndices*yIndices cell chars, row by row from the top, without borders or newlines.
+// FRAMED writes the header and bordered rows, exactly as Plane::print writes them to a file
+enum RenderFormat { RASTER, FRAMED };
+
+enum RenderStatus { RENDER_OK, RENDER_BUFFER_TOO_SMALL, RENDER_INVALID_ARGUMENT };
+
+// size of the SparsePlane a framed render used. Both are 0 if the window was graphed on a Plane
+struct RenderStats {
+    // 64 x 64 tiles allocated
+    size_t tileCount;
+    
+    // bytes held by tiles and the hash table
+    size_t memoryUsage;
+    
+    // default ctor
+    // post: no tiles were used
+    RenderStats();
+};
+
+// called with each batch of sampled points of the function, e.g. to print or analyze them
+typedef std::function<void(const double*, const double*, size_t)> SampleCallback;
+
+// renderFunction
+// graphs f(x) = polynomial across the window
+// pre: polynomial in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or polynomial can't be parsed. If stats is given,
+// it is set to the size of the SparsePlane used
+RenderStatus renderFunction(const std::string &polynomial, const RenderParams &params, RenderFormat format,
+                            std::ostream &outfile, const SampleCallback &onSamples = nullptr,
+                            RenderStats *stats = nullptr);
+
+// renderFunction for a buffer
+// post: writes the graph to buffer, which holds capacity chars, and sets written to the length of the
+// graph. Returns RENDER_BUFFER_TOO_SMALL if the graph is longer than capacity, in which case buffer holds
+// the first capacity chars of it and the call can be repeated with a buffer of written chars
+RenderStatus renderFunction(const std::string &polynomial, const RenderParams &params, RenderFormat format,
+                            char *buffer, size_t capacity, size_t &written, const SampleCallback &onSamples = nullptr);
+
+// renderParametric
+// graphs (a(x), b(x)) = (xParam, yParam) for tStart <= x <= tEnd
+// pre: xParam and yParam in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or either function can't be parsed. If stats is
+// given, it is set to the size of the SparsePlane used
+RenderStatus renderParametric(const std::string &xParam, const std::string &yParam, double tStart, double tEnd,
+                              const RenderParams &params, RenderFormat format, std::ostream &outfile,
+                              const SampleCallback &onSamples = nullptr, RenderStats *stats = nullptr);
+
+// renderParametric for a buffer
+// post: writes the graph to buffer, which holds capacity chars, and sets written to the length of the
+// graph. Returns RENDER_BUFFER_TOO_SMALL if the graph is longer than capacity, in which case buffer holds
+// the first capacity chars of it
+RenderStatus renderParametric(const std::string &xParam, const std::string &yParam, double tStart, double tEnd,
+                              const RenderParams &params, RenderFormat format, char *buffer, size_t capacity,
+                              size_t &written, const SampleCallback &onSamples = nullptr);
+
+
+// profileFunction
+// graphs f(x) = polynomial as renderFunction does in FRAMED format, a batch at a time on this thread, while
+// profiler times evaluating each batch ("[evaluate]"), every term and trig function inside it across the
+// batch, adding points to the plane ("[rasterize]") and writing the plane ("[write]"). derivative is ignored
+// pre: polynomial in the form accepted by parsePolynomial
+// post: writes the graph to outfile and returns RENDER_OK, or writes nothing and returns
+// RENDER_INVALID_ARGUMENT if the window has no samples or polynomial can't be parsed
+RenderStatus profileFunction(const std::string &polynomial, const RenderParams &params, std::ostream &outfile,
+                             Profiler &profiler);
+
+
+#endif /* Render_hpp */
@@ -0,0 +1,70 @@
+// File name: RenderC.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of functions in "RenderC.h"
+// Last Changed: 10/19/26
+
+#include "RenderC.h"
+#include <string>
+#include "Render.hpp"
+
+using namespace std;
+
+
+// toParams helper function
+// post: returns params as RenderParams, or false if a value is out of range
+static bool toParams(const grapher_params *params, int format, RenderParams &renderParams) {
+    if (params == NULL || params->precision < GRAPHER_EXACT || params->precision > GRAPHER_CELL_ACCURATE ||
+        (format != GRAPHER_RASTER && format != GRAPHER_FRAMED)) {
+        return false;
+    }
+    renderParams.x_length = params->x_length;
+    renderParams.y_length = params->y_length;
+    renderParams.xSamples = params->x_samples;
+    renderParams.ySamples = params->y_samples;
+    renderParams.precision = Precision(params->precision);
+    renderParams.derivative = params->derivative != 0;
+    return true;
+}
+
+
+// grapher_render_function
+// post: writes the graph of f(x) = polynomial to buffer, which holds capacity chars, sets *written to the
+// length of the graph and returns one of GRAPHER_OK, GRAPHER_BUFFER_TOO_SMALL or GRAPHER_INVALID_ARGUMENT
+extern "C" int grapher_render_function(const char *polynomial, const grapher_params *params, int format,
+                                       char *buffer, size_t capacity, size_t *written) {
+    RenderParams renderParams;
+    if (polynomial == NULL || written == NULL || (buffer == NULL && capacity != 0) ||
+        !toParams(params, format, renderParams)) {
+        return GRAPHER_INVALID_ARGUMENT;
+    }
+    // exceptions must not cross into C
+    try {
+        return renderFunction(polynomial, renderParams, RenderFormat(format), buffer, capacity, *written);
+    }
+    catch (...) {
+        return GRAPHER_INVALID_ARGUMENT;
+    }
+}
+
+
+// grapher_render_parametric
+// post: writes the graph of (a(x), b(x)) = (x_param, y_param) for t_start <= x <= t_end to buffer, which
+// holds capacity chars, sets *written to the length of the graph and returns one of GRAPHER_OK,
+// GRAPHER_BUFFER_TOO_SMALL or GRAPHER_INVALID_ARGUMENT
+extern "C" int grapher_render_parametric(const char *x_param, const char *y_param, double t_start, double t_end,
+                                         const grapher_params *params, int format, char *buffer, size_t capacity,
+                                         size_t *written) {
+    RenderParams renderParams;
+    if (x_param == NULL || y_param == NULL || written == NULL || (buffer == NULL && capacity != 0) ||
+        !toParams(params, format, renderParams)) {
+        return GRAPHER_INVALID_ARGUMENT;
+    }
+    try {
+        return renderParametric(x_param, y_param, t_start, t_end, renderParams, RenderFormat(format), buffer,
+                                capacity, *written);
+    }
+    catch (...) {
+        return GRAPHER_INVALID_ARGUMENT;
+    }
+}
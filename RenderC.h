@@ -0,0 +1,53 @@
+// File name: RenderC.h
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: C interface to the functions in "Render.hpp", for callers that can't use C++. Strings are
+// null terminated, and each call writes its graph into the caller's buffer. Like the C++ functions, calls
+// share no state and may run at the same time on any number of threads.
+// Last Changed: 10/19/26
+
+#ifndef RenderC_h
+#define RenderC_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* values of precision, matching Precision in "FastMath.hpp" */
+enum { GRAPHER_EXACT = 0, GRAPHER_FLOAT_ACCURATE = 1, GRAPHER_CELL_ACCURATE = 2 };
+
+/* values of format, matching RenderFormat in "Render.hpp" */
+enum { GRAPHER_RASTER = 0, GRAPHER_FRAMED = 1 };
+
+/* values returned, matching RenderStatus in "Render.hpp" */
+enum { GRAPHER_OK = 0, GRAPHER_BUFFER_TOO_SMALL = 1, GRAPHER_INVALID_ARGUMENT = 2 };
+
+/* window and sampling of a render, as in RenderParams */
+typedef struct {
+    size_t x_length, y_length;
+    size_t x_samples, y_samples;
+    int precision;
+    int derivative;
+} grapher_params;
+
+/* grapher_render_function
+   post: writes the graph of f(x) = polynomial to buffer, which holds capacity chars, sets *written to the
+   length of the graph and returns one of the values above */
+int grapher_render_function(const char *polynomial, const grapher_params *params, int format,
+                            char *buffer, size_t capacity, size_t *written);
+
+/* grapher_render_parametric
+   post: writes the graph of (a(x), b(x)) = (x_param, y_param) for t_start <= x <= t_end to buffer, which
+   holds capacity chars, sets *written to the length of the graph and returns one of the values above */
+int grapher_render_parametric(const char *x_param, const char *y_param, double t_start, double t_end,
+                              const grapher_params *params, int format, char *buffer, size_t capacity,
+                              size_t *written);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* RenderC_h */
@@ -0,0 +1,284 @@
+// File name: SparsePlane.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of classes in "SparsePlane.hpp"
+// Last Changed: 10/19/26
+
+#include "SparsePlane.hpp"
+#include "Plane.hpp"
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+const size_t SparsePlane::TILE_SIZE;
+
+// marks an unused slot in the hash table
+static const size_t EMPTY_KEY = size_t(-1);
+
+// number of slots the hash table starts with. Always a power of two
+static const size_t INITIAL_SLOTS = 64;
+
+
+// hashTile helper function
+// post: returns a well mixed hash of tile, so neighbouring tiles land in different slots
+static size_t hashTile(size_t tile) {
+    unsigned long long hash = tile;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return size_t(hash);
+}
+
+
+// alternate ctor
+// creates a SparsePlane with the same window and resolution as Plane(x, y, x_samples, y_samples)
+// pre: obj doesn't exist
+// post: SparsePlane exists with no tiles allocated, so every cell is empty
+SparsePlane::SparsePlane(size_t x, size_t y, size_t x_samples, size_t y_samples) :
+x_length(x),
+y_length(y),
+X_SAMPLES_PER_UNIT(x_samples),
+Y_SAMPLES_PER_UNIT(y_samples),
+xIndices(2*int(x*x_samples) + 1),
+yIndices(2*int(y*y_samples) + 1),
+xScale(double(x_samples)),
+yScale(double(y_samples)),
+xOffset(int(x*x_samples)),
+yOffset(int(y*y_samples)),
+xTiles((size_t(xIndices) + TILE_SIZE - 1)/TILE_SIZE),
+keys(INITIAL_SLOTS, EMPTY_KEY),
+slots(INITIAL_SLOTS, 0),
+tileCount(0)
+{
+    // nothing to do
+}
+
+
+// findTile helper function
+// post: returns the offset of tile's cells in cells, or EMPTY_KEY if tile has not been allocated
+size_t SparsePlane::findTile(size_t tile) const {
+    size_t mask = keys.size() - 1;
+    for (size_t slot = hashTile(tile) & mask; ; slot = (slot + 1) & mask) {
+        if (keys[slot] == tile) {
+            return slots[slot];
+        }
+        if (keys[slot] == EMPTY_KEY) {
+            return EMPTY_KEY;
+        }
+    }
+}
+
+
+// getTile helper function
+// post: returns the offset of tile's cells in cells, allocating an empty tile if needed
+size_t SparsePlane::getTile(size_t tile) {
+    size_t mask = keys.size() - 1;
+    size_t slot = hashTile(tile) & mask;
+    while (keys[slot] != EMPTY_KEY) {
+        if (keys[slot] == tile) {
+            return slots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    // tile doesn't exist yet. Keep the table at most half full so probe sequences stay short
+    if (2*(tileCount + 1) > keys.size()) {
+        grow();
+        return getTile(tile);
+    }
+    keys[slot] = tile;
+    slots[slot] = cells.size();
+    cells.resize(cells.size() + TILE_SIZE*TILE_SIZE, ' ');
+    tileCount++;
+    return slots[slot];
+}
+
+
+// grow helper function
+// post: hash table holds twice as many slots, with every tile rehashed into it
+void SparsePlane::grow() {
+    vector<size_t> oldKeys(2*keys.size(), EMPTY_KEY);
+    vector<size_t> oldSlots(2*slots.size(), 0);
+    oldKeys.swap(keys);
+    oldSlots.swap(slots);
+    size_t mask = keys.size() - 1;
+    for (size_t count = 0; count < oldKeys.size(); count++) {
+        if (oldKeys[count] == EMPTY_KEY) {
+            continue;
+        }
+        size_t slot = hashTile(oldKeys[count]) & mask;
+        while (keys[slot] != EMPTY_KEY) {
+            slot = (slot + 1) & mask;
+        }
+        keys[slot] = oldKeys[count];
+        slots[slot] = oldSlots[count];
+    }
+}
+
+
+// fillCell helper function
+// pre: xIndex and yIndex are within the SparsePlane
+// post: cell is filled with glyph if one is given, else with '*', or 'x' at the origin
+void SparsePlane::fillCell(size_t xIndex, size_t yIndex, char glyph) {
+    size_t tile = (yIndex/TILE_SIZE)*xTiles + xIndex/TILE_SIZE;
+    size_t offset = getTile(tile) + (yIndex % TILE_SIZE)*TILE_SIZE + xIndex % TILE_SIZE;
+    if (glyph != '\0') {
+        cells[offset] = glyph;
+    }
+    else {
+        cells[offset] = (xIndex == size_t(xOffset) && yIndex == size_t(yOffset)) ? 'x' : '*';
+    }
+}
+
+
+// addPoint
+// post: adds Point to SparsePlane, if it is within the window
+void SparsePlane::addPoint(double x, double y) {
+    addPoints(&x, &y, 1);
+}
+
+
+// addPoints
+// pre: xs and ys each hold count coordinates
+// post: every (xs[i], ys[i]) within the window is added to the SparsePlane, drawn with glyph if one
+// is given
+void SparsePlane::addPoints(const double *xs, const double *ys, size_t count, char glyph) {
+    for (size_t pointCount = 0; pointCount < count; pointCount++) {
+        double xIndex = toColumn(xs[pointCount], xScale, xOffset);
+        double yIndex = toRow(ys[pointCount], yScale, yOffset);
+        if (xIndex >= 0 && xIndex < xIndices && yIndex >= 0 && yIndex < yIndices) {
+            fillCell(size_t(xIndex), size_t(yIndex), glyph);
+        }
+    }
+}
+
+
+// isEmpty
+// pre: (x, y) is within the window
+// post: returns true if (x, y) has not been filled, else false
+bool SparsePlane::isEmpty(double x, double y) const {
+    size_t xIndex = size_t(toColumn(x, xScale, xOffset));
+    size_t yIndex = size_t(toRow(y, yScale, yOffset));
+    size_t offset = findTile((yIndex/TILE_SIZE)*xTiles + xIndex/TILE_SIZE);
+    if (offset == EMPTY_KEY) {
+        return true;
+    }
+    return cells[offset + (yIndex % TILE_SIZE)*TILE_SIZE + xIndex % TILE_SIZE] == ' ';
+}
+
+
+// getXIndices
+// post: returns number of columns, 2*x_length*X_SAMPLES_PER_UNIT + 1
+int SparsePlane::getXIndices() const {
+    return xIndices;
+}
+
+
+// getYIndices
+// post: returns number of rows, 2*y_length*Y_SAMPLES_PER_UNIT + 1
+int SparsePlane::getYIndices() const {
+    return yIndices;
+}
+
+
+// getTileCount
+// post: returns number of tiles allocated
+size_t SparsePlane::getTileCount() const {
+    return tileCount;
+}
+
+
+// getMemoryUsage
+// post: returns bytes held by tiles and the hash table
+size_t SparsePlane::getMemoryUsage() const {
+    return cells.capacity() + keys.capacity()*sizeof(size_t) + slots.capacity()*sizeof(size_t);
+}
+
+
+// print for polynomials
+// post: prints SparsePlane, in the same format as Plane
+void SparsePlane::print(string filename, string polynomial) {
+    ofstream outfile;
+    outfile.open(filename, ios::ate);
+    printHeader(outfile, polynomial);
+    printRows(outfile, 0, yIndices);
+    outfile.close();
+}
+
+
+// print for parametric
+// post: prints SparsePlane, in the same format as Plane
+void SparsePlane::print(string filename, string xParam, string yParam, double tStart, double tEnd) {
+    ofstream outfile;
+    outfile.open(filename, ios::ate);
+    printHeader(outfile, xParam, yParam, tStart, tEnd);
+    printRows(outfile, 0, yIndices);
+    outfile.close();
+}
+
+
+// printHeader for polynomials
+// post: writes the function, scale and window lines print starts with
+void SparsePlane::printHeader(ostream &outfile, string polynomial) const {
+    printPlaneHeader(outfile, polynomial, x_length, y_length, X_SAMPLES_PER_UNIT, Y_SAMPLES_PER_UNIT);
+}
+
+
+// printHeader for parametric
+// post: writes the function, scale and window lines print starts with
+void SparsePlane::printHeader(ostream &outfile, string xParam, string yParam, double tStart, double tEnd) const {
+    printPlaneHeader(outfile, xParam, yParam, tStart, tEnd, x_length, y_length, X_SAMPLES_PER_UNIT, Y_SAMPLES_PER_UNIT);
+}
+
+
+// printRows
+// pre: 0 <= firstRow <= lastRow <= yIndices
+// post: writes rows firstRow up to lastRow between side borders, preceded by the top border if firstRow
+// is 0 and followed by the bottom border if lastRow is yIndices. Rows in unallocated tiles are spaces
+void SparsePlane::printRows(ostream &outfile, int firstRow, int lastRow) const {
+    size_t columns = size_t(xIndices);
+    if (firstRow == 0) {
+        outfile << "╔";
+        for (size_t topBorder = 0; topBorder < columns; topBorder++) {
+            outfile << "═";
+        }
+        outfile << "╗\n";
+    }
+    vector<size_t> rowTiles(xTiles);
+    string row;
+    for (size_t yCol = firstRow; yCol < size_t(lastRow); yCol++) {
+        // look up each tile of a band of TILE_SIZE rows once
+        if (yCol == size_t(firstRow) || yCol % TILE_SIZE == 0) {
+            for (size_t tileCol = 0; tileCol < xTiles; tileCol++) {
+                rowTiles[tileCol] = findTile((yCol/TILE_SIZE)*xTiles + tileCol);
+            }
+        }
+        row = "║";
+        for (size_t tileCol = 0; tileCol < xTiles; tileCol++) {
+            size_t width = std::min(TILE_SIZE, columns - tileCol*TILE_SIZE);
+            if (rowTiles[tileCol] == EMPTY_KEY) {
+                row.append(width, ' ');
+            }
+            else {
+                row.append(&cells[rowTiles[tileCol] + (yCol % TILE_SIZE)*TILE_SIZE], width);
+            }
+        }
+        // the origin is marked even when its tile was never allocated
+        if (yCol == size_t(yOffset) && row[3 + xOffset] == ' ') {
+            row[3 + xOffset] = 'o';
+        }
+        row += "║";
+        outfile << row << '\n';
+    }
+    if (lastRow == yIndices) {
+        outfile << "╚";
+        for (size_t bottomBorder = 0; bottomBorder < columns; bottomBorder++) {
+            outfile << "═";
+        }
+        outfile << "╝";
+    }
+}
@@ -0,0 +1,128 @@
+// File name: SparsePlane.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: SparsePlane is a Plane for very large windows. A curve only fills O(width) of the
+// O(width x height) cells in a window, so instead of allocating every cell up front, cells are grouped
+// into TILE_SIZE x TILE_SIZE tiles and a tile is allocated only when a point lands in it. Tiles are found
+// through an open addressing hash table keyed by tile position. Cells in tiles that were never allocated
+// are empty, and print writes them as ' ' without storing them. Memory is proportional to the number of
+// tiles the curve passes through.
+// Coordinates map to cells exactly as in Plane, and print writes the same file Plane::print would.
+// Last Changed: 10/19/26
+
+#ifndef SparsePlane_hpp
+#define SparsePlane_hpp
+
+#include <stdio.h>
+#include <string>
+#include <iosfwd>
+#include <vector>
+
+class SparsePlane {
+private:
+    // width and height of a tile, in cells
+    static const size_t TILE_SIZE = 64;
+    
+    size_t x_length, y_length;
+    size_t X_SAMPLES_PER_UNIT;
+    size_t Y_SAMPLES_PER_UNIT;
+    int xIndices;
+    int yIndices;
+    
+    // per-axis scale and offset mapping a coordinate to a cell index, as in Plane
+    double xScale, yScale;
+    int xOffset, yOffset;
+    
+    // number of tile columns covering xIndices
+    size_t xTiles;
+    
+    // hash table of tiles. keys[slot] holds the tile number (tileRow*xTiles + tileColumn) stored in slot,
+    // or EMPTY_KEY, and slots[slot] holds the tile's position in cells
+    std::vector<size_t> keys;
+    std::vector<size_t> slots;
+    
+    // cells of every allocated tile, TILE_SIZE*TILE_SIZE chars per tile, rows stored top to bottom
+    std::vector<char> cells;
+    size_t tileCount;
+    
+    // findTile helper function
+    // post: returns the offset of tile's cells in cells, or EMPTY_KEY if tile has not been allocated
+    size_t findTile(size_t tile) const;
+    
+    // getTile helper function
+    // post: returns the offset of tile's cells in cells, allocating an empty tile if needed
+    size_t getTile(size_t tile);
+    
+    // grow helper function
+    // post: hash table holds twice as many slots, with every tile rehashed into it
+    void grow();
+    
+    // fillCell helper function
+    // pre: xIndex and yIndex are within the SparsePlane
+    // post: cell is filled with glyph if one is given, else with '*', or 'x' at the origin
+    void fillCell(size_t xIndex, size_t yIndex, char glyph);
+    
+public:
+    
+    // alternate ctor
+    // creates a SparsePlane with the same window and resolution as Plane(x, y, x_samples, y_samples)
+    // pre: obj doesn't exist
+    // post: SparsePlane exists with no tiles allocated, so every cell is empty
+    SparsePlane(size_t x, size_t y, size_t x_samples, size_t y_samples);
+    
+    // addPoint
+    // post: adds Point to SparsePlane, if it is within the window
+    void addPoint(double x, double y);
+    
+    // addPoints
+    // pre: xs and ys each hold count coordinates
+    // post: every (xs[i], ys[i]) within the window is added to the SparsePlane, drawn with glyph if one
+    // is given
+    void addPoints(const double *xs, const double *ys, size_t count, char glyph = '\0');
+    
+    // isEmpty
+    // pre: (x, y) is within the window
+    // post: returns true if (x, y) has not been filled, else false
+    bool isEmpty(double x, double y) const;
+    
+    // getXIndices
+    // post: returns number of columns, 2*x_length*X_SAMPLES_PER_UNIT + 1
+    int getXIndices() const;
+    
+    // getYIndices
+    // post: returns number of rows, 2*y_length*Y_SAMPLES_PER_UNIT + 1
+    int getYIndices() const;
+    
+    // getTileCount
+    // post: returns number of tiles allocated
+    size_t getTileCount() const;
+    
+    // getMemoryUsage
+    // post: returns bytes held by tiles and the hash table
+    size_t getMemoryUsage() const;
+    
+    // print for polynomials
+    // post: prints SparsePlane, in the same format as Plane
+    void print(std::string filename, std::string polynomial);
+    
+    // print for parametric
+    // post: prints SparsePlane, in the same format as Plane
+    void print(std::string filename, std::string xParam, std::string yParam, double tStart, double tEnd);
+    
+    // printHeader for polynomials
+    // post: writes the function, scale and window lines print starts with
+    void printHeader(std::ostream &outfile, std::string polynomial) const;
+    
+    // printHeader for parametric
+    // post: writes the function, scale and window lines print starts with
+    void printHeader(std::ostream &outfile, std::string xParam, std::string yParam, double tStart, double tEnd) const;
+    
+    // printRows
+    // pre: 0 <= firstRow <= lastRow <= yIndices
+    // post: writes rows firstRow up to lastRow between side borders, preceded by the top border if firstRow
+    // is 0 and followed by the bottom border if lastRow is yIndices. Rows in unallocated tiles are spaces
+    void printRows(std::ostream &outfile, int firstRow, int lastRow) const;
+};
+
+
+#endif /* SparsePlane_hpp */
@@ -0,0 +1,224 @@
+// File name: Sweep.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Definitions of functions in "Sweep.hpp"
+// Last Changed: 10/19/26
+
+#include "Sweep.hpp"
+#include "Plane.hpp"
+#include "Parser.hpp"
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+// number of frames rendered per worker thread before a batch is written out. Bounds memory to a few
+// rasters per thread no matter how many frames the sweep has
+static const size_t FRAMES_PER_THREAD = 4;
+
+
+// toParameterString helper function
+// post: returns value in fixed notation without trailing zeros, since split and getCoeff cannot read
+// scientific notation
+static string toParameterString(double value) {
+    ostringstream out;
+    out.setf(ios::fixed);
+    out.precision(8);
+    out << value;
+    string str = out.str();
+    str.erase(str.find_last_not_of('0') + 1);
+    if (str[str.length() - 1] == '.') {
+        str.erase(str.length() - 1);
+    }
+    if (str == "-0") {
+        str = "0";
+    }
+    return str;
+}
+
+
+// substituteParameter
+// pre: parameter appears in expression only where a coefficient or constant may appear
+// post: returns expression with every occurrence of parameter replaced by value. A negative value
+// absorbs the sign before it, so x^2+kx with k = -2 becomes x^2-2x
+string substituteParameter(string expression, char parameter, double value) {
+    string magnitude = toParameterString(std::fabs(value));
+    bool isNeg = value < 0 && magnitude != "0";
+    string result = "";
+    for (size_t count = 0; count < expression.length(); count++) {
+        if (expression[count] != parameter) {
+            result += expression[count];
+        }
+        else if (!isNeg) {
+            result += magnitude;
+        }
+        else if (!result.empty() && result[result.length() - 1] == '+') {
+            result[result.length() - 1] = '-';
+            result += magnitude;
+        }
+        else if (!result.empty() && result[result.length() - 1] == '-') {
+            result[result.length() - 1] = '+';
+            result += magnitude;
+        }
+        else {
+            result += "-" + magnitude;
+        }
+    }
+    // a leading '+' left by "-k..." is not part of the grammar
+    if (!result.empty() && result[0] == '+') {
+        result.erase(0, 1);
+    }
+    return result;
+}
+
+
+// encodeDelta
+// pre: previous and current are rasters of the same Plane dimensions
+// post: returns the runs of cells that differ between previous and current, one "<skip> <length> <chars>"
+// line per run, and sets runs to the number of lines
+string encodeDelta(const string &previous, const string &current, size_t &runs) {
+    ostringstream out;
+    runs = 0;
+    size_t lastEnd = 0;
+    size_t count = 0;
+    while (count < current.length()) {
+        if (previous[count] == current[count]) {
+            count++;
+            continue;
+        }
+        size_t runStart = count;
+        while (count < current.length() && previous[count] != current[count]) {
+            count++;
+        }
+        out << runStart - lastEnd << ' ' << count - runStart << ' ' << current.substr(runStart, count - runStart) << '\n';
+        lastEnd = count;
+        runs++;
+    }
+    return out.str();
+}
+
+
+// renderFrame helper function
+// post: returns raster of expression sampled across the window with parameter k set to kVal
+static string renderFrame(const string &expression, double kVal, size_t x, size_t y, size_t x_samples, size_t y_samples,
+                          Precision precision) {
+    Plane graph(x, y, x_samples, y_samples);
+    vector<string> polySplit = split(substituteParameter(expression, 'k', kVal));
+    vector<double> xVals;
+    for (double xVal = -double(x); xVal <= double(x); xVal = xVal + 1/double(x_samples)) {
+        xVals.push_back(xVal);
+    }
+    vector<double> yVals(xVals.size());
+    parsePolynomial(polySplit, xVals.data(), xVals.size(), yVals.data(), precision);
+    graph.addPoints(xVals.data(), yVals.data(), xVals.size());
+    return graph.getRaster();
+}
+
+
+// renderSweep
+// pre: expression is a function of x containing the free parameter 'k'
+// post: renders expression for frames values of k from kStart to kEnd in a window of the given size and
+// resolution, writes the frames to filename as a keyframe followed by deltas and returns RENDER_OK. Writes
+// nothing and returns RENDER_INVALID_ARGUMENT if there are no frames, the window has no samples or
+// expression can't be parsed
+RenderStatus renderSweep(string filename, string expression, double kStart, double kEnd, size_t frames,
+                         size_t x, size_t y, size_t x_samples, size_t y_samples, Precision precision) {
+    if (frames == 0 || x_samples == 0 || y_samples == 0) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    
+    // substituting k only changes numbers, so an expression that parses at kStart parses at every k. It is
+    // checked here because an exception on a worker thread would end the program
+    try {
+        parsePolynomial(split(substituteParameter(expression, 'k', kStart)), -double(x), precision);
+    }
+    catch (std::exception &error) {
+        return RENDER_INVALID_ARGUMENT;
+    }
+    
+    size_t columns = 2*x*x_samples + 1;
+    size_t rows = 2*y*y_samples + 1;
+    
+    size_t threadCount = std::max(1u, thread::hardware_concurrency());
+    size_t batchSize = threadCount*FRAMES_PER_THREAD;
+    
+    vector<double> kVals(frames);
+    for (size_t frame = 0; frame < frames; frame++) {
+        kVals[frame] = frames == 1 ? kStart : kStart + (kEnd - kStart)*double(frame)/double(frames - 1);
+    }
+    
+    ofstream outfile;
+    outfile.open(filename, ios::ate);
+    
+    // formatting...
+    outfile << "f(x) = " << expression << endl;
+    outfile << "X SCALE: 1 char = " << 1/double(x_samples) << "units." << endl;
+    outfile << "Y SCALE: 1 char = " << 1/double(y_samples) << "units." << endl;
+    outfile << "Window: -" << x << " < x < " << x << " | -" << y << " < y < " << y << endl;
+    outfile << kStart << " <= k <= " << kEnd << endl;
+    outfile << "Frames: " << frames << " | Cells: " << columns << " x " << rows << endl << endl;
+    
+    // previous holds the last frame of the batch before, which the first delta of a batch is taken against
+    string previous;
+    vector<string> rasters(batchSize);
+    vector<string> deltas(batchSize);
+    vector<size_t> runs(batchSize);
+    
+    for (size_t batchStart = 0; batchStart < frames; batchStart += batchSize) {
+        size_t batch = std::min(batchSize, frames - batchStart);
+        
+        // render every frame of the batch, each thread taking every threadCount'th frame
+        vector<thread> workers;
+        for (size_t worker = 0; worker < threadCount; worker++) {
+            workers.push_back(thread([&, worker]() {
+                for (size_t frame = worker; frame < batch; frame += threadCount) {
+                    rasters[frame] = renderFrame(expression, kVals[batchStart + frame], x, y, x_samples, y_samples, precision);
+                }
+            }));
+        }
+        for (size_t worker = 0; worker < workers.size(); worker++) {
+            workers[worker].join();
+        }
+        
+        // encode each frame against the one before it, again in parallel
+        workers.clear();
+        for (size_t worker = 0; worker < threadCount; worker++) {
+            workers.push_back(thread([&, worker]() {
+                for (size_t frame = worker; frame < batch; frame += threadCount) {
+                    if (batchStart + frame == 0) {
+                        continue;
+                    }
+                    const string &before = frame == 0 ? previous : rasters[frame - 1];
+                    deltas[frame] = encodeDelta(before, rasters[frame], runs[frame]);
+                }
+            }));
+        }
+        for (size_t worker = 0; worker < workers.size(); worker++) {
+            workers[worker].join();
+        }
+        
+        for (size_t frame = 0; frame < batch; frame++) {
+            size_t frameNum = batchStart + frame;
+            if (frameNum == 0) {
+                outfile << "KEYFRAME 0 k=" << kVals[0] << endl;
+                for (size_t row = 0; row < rows; row++) {
+                    outfile << rasters[frame].substr(row*columns, columns) << '\n';
+                }
+            }
+            else {
+                outfile << "FRAME " << frameNum << " k=" << kVals[frameNum] << " RUNS " << runs[frame] << '\n';
+                outfile << deltas[frame];
+            }
+        }
+        previous.swap(rasters[batch - 1]);
+    }
+    
+    outfile.close();
+    return RENDER_OK;
+}
@@ -0,0 +1,47 @@
+// File name: Sweep.hpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Sweep renders a family of functions f(x) with a free parameter k, e.g. sin(kx), for
+// evenly spaced values of k across a range. Frames are rendered in parallel and written to a single
+// sequence file: the first frame is stored whole as a keyframe, and every later frame is stored as
+// run-length deltas against the frame before it.
+//
+// Sequence file format:
+//   header lines, formatted like Plane::print, ending with "Frames: <n> | Cells: <columns> x <rows>"
+//   "KEYFRAME 0 k=<value>" followed by <rows> lines of <columns> chars
+//   "FRAME <i> k=<value> RUNS <r>" followed by r lines "<skip> <length> <chars>", where skip counts
+//   unchanged cells since the end of the previous run (cells counted row by row from the top) and
+//   chars holds the length new cells
+// Last Changed: 10/19/26
+
+#ifndef Sweep_hpp
+#define Sweep_hpp
+
+#include <stdio.h>
+#include <string>
+#include "FastMath.hpp"
+#include "Render.hpp"
+
+// substituteParameter
+// pre: parameter appears in expression only where a coefficient or constant may appear
+// post: returns expression with every occurrence of parameter replaced by value. A negative value
+// absorbs the sign before it, so x^2+kx with k = -2 becomes x^2-2x
+std::string substituteParameter(std::string expression, char parameter, double value);
+
+// encodeDelta
+// pre: previous and current are rasters of the same Plane dimensions
+// post: returns the runs of cells that differ between previous and current, one "<skip> <length> <chars>"
+// line per run, and sets runs to the number of lines
+std::string encodeDelta(const std::string &previous, const std::string &current, size_t &runs);
+
+// renderSweep
+// pre: expression is a function of x containing the free parameter 'k'
+// post: renders expression for frames values of k from kStart to kEnd in a window of the given size and
+// resolution, writes the frames to filename as a keyframe followed by deltas and returns RENDER_OK. Writes
+// nothing and returns RENDER_INVALID_ARGUMENT if there are no frames, the window has no samples or
+// expression can't be parsed
+RenderStatus renderSweep(std::string filename, std::string expression, double kStart, double kEnd, size_t frames,
+                 size_t x, size_t y, size_t x_samples, size_t y_samples, Precision precision = EXACT);
+
+
+#endif /* Sweep_hpp */
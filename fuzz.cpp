@@ -0,0 +1,903 @@
+// File name: fuzz.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Differential fuzzer for every fast way of evaluating and graphing a function. Random
+// functions and windows are drawn from the grammar the parser accepts, and each is graphed the reference
+// way: parsePolynomial at every x, addPoint for every point and printRows. Every other path is checked
+// against it, with sampled values compared within tolerance and graphs compared cell for cell. The
+// approximate trig precisions may only move a point to another cell if the exact value is within their
+// tolerance of the boundary between the cells. Slopes from dual numbers are checked against central
+// differences, each frame of a parameter sweep against that frame graphed on its own, and each coarser
+// level of a zoom pyramid against the reference OR-reduced to it. Each case is also graphed parametrically
+// against another random function, and fixed thin curves in a window of more than SPARSE_CELL_LIMIT cells
+// must be graphed on a SparsePlane as the reference graphs them on one. CurveAnalyzer must find the roots and
+// extrema of fixed functions that land on samples or flat steps. Each path is timed against the part of
+// the reference it replaces, and its speedup is reported. Malformed functions, fixed ones and each case
+// with a dangling sign or a missing parenthesis, must be rejected by the library, and the fixed ones by the
+// zoom pyramid as well. Usage: fuzz [cases] [seed]. A sweep writes fuzz.<seed>.sweep in the working
+// directory, removed at the end. Returns 1 if any path differs.
+// Last Changed: 10/19/26
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include "Plane.hpp"
+#include "SparsePlane.hpp"
+#include "Parser.hpp"
+#include "Render.hpp"
+#include "Pyramid.hpp"
+#include "Profiler.hpp"
+#include "Sweep.hpp"
+#include "Analysis.hpp"
+using namespace std;
+
+typedef std::chrono::steady_clock Clock;
+
+// values from paths that should match the reference exactly may differ by this much, relative to the value
+static const double VALUE_TOLERANCE = 1e-12;
+
+// tolerance of each approximate precision, relative to 1 + |f(x)|
+static const double FLOAT_TOLERANCE = 1e-6;
+static const double CELL_TOLERANCE = 1e-3;
+
+// slopes from dual numbers may differ from central differences by this much, relative to 1 + |f'(x)|, where
+// central differences with three step sizes agree to within a tenth of it
+static const double SLOPE_TOLERANCE = 1e-4;
+
+// largest step of the central differences, relative to 1 + |x|
+static const double SLOPE_STEP = 1e-6;
+
+// frames of k from -1 to 1 in each sweep
+static const size_t SWEEP_FRAMES = 5;
+
+// most levels of each zoom pyramid, limited by how often the samples per unit can be halved
+static const size_t PYRAMID_LEVELS = 3;
+
+// functions the parser must reject without reading past them
+static const char *MALFORMED[] = {"", "x+", "x-", "-", "+", "sin(x", "sin(x)+", "sin(x))", "x++1", ")x(",
+                                   "3sin(x^2", "sin(kx", "q(x)", "tan"};
+
+// function sampled at a fixed step from -end to end, with the roots and extrema CurveAnalyzer must find.
+// Their roots and extrema land on samples or flat steps, which strict comparisons between neighbouring
+// samples miss. x^2-0.5x and x^3-x are written so the parser reads them as such, since it drops the sign
+// of a second term and reads the exponent of x^3 as 2
+struct AnalysisCase {
+    const char *function;
+    double step, end;
+    vector<double> roots, minima, maxima;
+};
+
+static const AnalysisCase ANALYSIS_CASES[] = {
+    {"-0.5x+x^2", 0.5, 2, {0, 0.5}, {0.25}, {}},
+    {"x^2", 0.5, 2, {0}, {0}, {}},
+    {"-x+1x^3", 0.5, 2, {-1, 0, 1}, {0.5773502691896258}, {-0.5773502691896258}},
+    {"sin(x)", 0.25, 4, {-3.141592653589793, 0, 3.141592653589793}, {-1.5707963267948966}, {1.5707963267948966}}
+};
+
+// roots and extrema found may differ from the exact ones by this much
+static const double ANALYSIS_TOLERANCE = 1e-6;
+
+// functions graphed framed in SPARSE_WINDOW, which has more than SPARSE_CELL_LIMIT cells, so the library
+// graphs them on a SparsePlane. Each is a thin curve, so only a few tiles are allocated
+static const char *SPARSE_FUNCTIONS[] = {"0.5x", "x^2", "300sin(0.01x)", "-0.001x^2+700"};
+static const size_t SPARSE_WINDOW = 1000;
+
+// circle graphed parametrically in SPARSE_WINDOW, for -SPARSE_T <= x <= SPARSE_T
+static const char *SPARSE_X_PARAM = "900cos(0.1x)";
+static const char *SPARSE_Y_PARAM = "900sin(0.1x)";
+static const double SPARSE_T = 32;
+
+// mismatches of each path printed in full before the rest are only counted
+static const size_t MISMATCHES_SHOWN = 5;
+
+// part of the reference each path replaces
+enum Baseline { EVALUATE, RASTERIZE, RENDER, PARAMETRIC, FRAMES };
+static const char *BASELINE_NAMES[] = {"evaluate", "rasterize", "render", "parametric render", "frame renders"};
+
+// checks, mismatches and time of one path across every case
+struct PathResult {
+    const char *name;
+    Baseline baseline;
+    size_t checks;
+    size_t mismatches;
+    size_t excused;
+    double seconds;
+};
+
+// function and window of one case
+struct Case {
+    string function;
+    size_t x, y, xSamples, ySamples;
+};
+
+// reference graph of one case
+struct Reference {
+    vector<string> polySplit;
+    vector<double> xs, ys;
+    string header, rows, raster;
+};
+
+
+// secondsSince helper function
+// post: returns seconds from start until now
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+// pick helper function
+// post: returns a uniformly random integer in [low, high]
+static int pick(mt19937 &rng, int low, int high) {
+    return uniform_int_distribution<int>(low, high)(rng);
+}
+
+
+// coefficient helper function
+// post: returns a random positive coefficient: none, an integer or a decimal
+static string coefficient(mt19937 &rng) {
+    switch (pick(rng, 0, 3)) {
+        case 0:
+            return "";
+        case 1:
+        case 2:
+            return to_string(pick(rng, 1, 9));
+        default:
+            return to_string(pick(rng, 0, 9)) + "." + to_string(pick(rng, 1, 9));
+    }
+}
+
+
+// monomial helper function
+// post: returns a random Ax or Ax^n
+static string monomial(mt19937 &rng) {
+    string term = coefficient(rng) + "x";
+    if (pick(rng, 0, 1)) {
+        term += "^" + to_string(pick(rng, 2, 4));
+    }
+    return term;
+}
+
+
+// randomTerm helper function
+// post: returns a random monomial, constant or trig function of a monomial. Trig functions aren't nested,
+// followed by a coefficient or raised to a power, and their arguments hold no + or -, since the parser
+// doesn't read those forms
+static string randomTerm(mt19937 &rng) {
+    static const char *TRIG[] = {"sin", "cos", "tan"};
+    switch (pick(rng, 0, 5)) {
+        case 0:
+        case 1:
+        case 2:
+            return monomial(rng);
+        case 3:
+        {
+            string constant = coefficient(rng);
+            return constant.empty() ? "1" : constant;
+        }
+        default:
+            return coefficient(rng) + TRIG[pick(rng, 0, 2)] + "(" + monomial(rng) + ")";
+    }
+}
+
+
+// randomCase helper function
+// post: returns a function of one to four terms, in a window of at most about 60000 cells
+static Case randomCase(mt19937 &rng) {
+    Case generated;
+    generated.function = pick(rng, 0, 3) == 0 ? "-" : "";
+    size_t terms = size_t(pick(rng, 1, 4));
+    for (size_t term = 0; term < terms; term++) {
+        if (term != 0) {
+            generated.function += pick(rng, 0, 1) ? "+" : "-";
+        }
+        generated.function += randomTerm(rng);
+    }
+    generated.x = size_t(pick(rng, 1, 15));
+    generated.y = size_t(pick(rng, 1, 15));
+    generated.xSamples = size_t(pick(rng, 1, int(120/generated.x)));
+    generated.ySamples = size_t(pick(rng, 1, int(120/generated.y)));
+    return generated;
+}
+
+
+// sameValue helper function
+// post: returns whether value matches reference within VALUE_TOLERANCE. NaNs match each other
+static bool sameValue(double value, double reference) {
+    if (std::isnan(value) || std::isnan(reference)) {
+        return std::isnan(value) && std::isnan(reference);
+    }
+    return value == reference || std::fabs(value - reference) <= VALUE_TOLERANCE*(1 + std::fabs(reference));
+}
+
+
+// cellRow helper function
+// post: returns row of the cell y falls in, as Plane rounds it, or a large value if y isn't finite
+static double cellRow(double y, size_t ySamples) {
+    return std::isfinite(y) ? std::round(double(ySamples)*y) : 1e300;
+}
+
+
+// nearBoundary helper function
+// post: returns whether y is within tolerance of the boundary between two rows of cells
+static bool nearBoundary(double y, size_t ySamples, double tolerance) {
+    double scaled = double(ySamples)*y;
+    double boundary = std::floor(scaled) + 0.5;
+    return std::fabs(scaled - boundary) <= double(ySamples)*tolerance*(1 + std::fabs(y));
+}
+
+
+// report helper function
+// post: counts a mismatch of path in testCase, and prints it if few of path's mismatches have been printed
+static void report(PathResult &path, const Case &testCase, const string &detail) {
+    if (path.mismatches++ < MISMATCHES_SHOWN) {
+        cout << path.name << ": f(x) = " << testCase.function << " in window " << testCase.x << " x " << testCase.y
+             << " at " << testCase.xSamples << " x " << testCase.ySamples << " samples per unit: " << detail << endl;
+    }
+}
+
+
+// compareText helper function
+// post: records a check of path, and a mismatch if text differs from reference
+static void compareText(PathResult &path, const Case &testCase, const string &text, const string &reference) {
+    path.checks++;
+    if (text != reference) {
+        size_t index = 0;
+        while (index < text.size() && index < reference.size() && text[index] == reference[index]) {
+            index++;
+        }
+        report(path, testCase, "output differs from char " + to_string(index));
+    }
+}
+
+
+// compareValues helper function
+// post: records a check of path, and a mismatch if any value differs from the reference samples
+static void compareValues(PathResult &path, const Case &testCase, const vector<double> &values, const Reference &reference) {
+    path.checks++;
+    for (size_t index = 0; index < values.size(); index++) {
+        if (!sameValue(values[index], reference.ys[index])) {
+            ostringstream detail;
+            detail.precision(17);
+            detail << "f(" << reference.xs[index] << ") = " << values[index] << ", reference " << reference.ys[index];
+            report(path, testCase, detail.str());
+            return;
+        }
+    }
+}
+
+
+// buildReference helper function
+// post: graphs testCase the reference way into reference and adds the time of each part to evaluateTime,
+// rasterizeTime and renderTime
+static void buildReference(const Case &testCase, Reference &reference, double &evaluateTime, double &rasterizeTime,
+                           double &renderTime) {
+    reference.polySplit = split(testCase.function);
+    Clock::time_point start = Clock::now();
+    for (double xVal = -double(testCase.x); xVal <= double(testCase.x); xVal = xVal + 1/double(testCase.xSamples)) {
+        reference.xs.push_back(xVal);
+        reference.ys.push_back(parsePolynomial(reference.polySplit, xVal));
+    }
+    double evaluate = secondsSince(start);
+    
+    start = Clock::now();
+    Plane graph(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+    for (size_t index = 0; index < reference.xs.size(); index++) {
+        graph.addPoint(reference.xs[index], reference.ys[index]);
+    }
+    ostringstream header, rows;
+    graph.printHeader(header, testCase.function);
+    graph.printRows(rows, 0, graph.getYIndices());
+    double rasterize = secondsSince(start);
+    
+    reference.header = header.str();
+    reference.rows = rows.str();
+    reference.raster = graph.getRaster();
+    evaluateTime += evaluate;
+    rasterizeTime += rasterize;
+    renderTime += evaluate + rasterize;
+}
+
+
+// referenceRaster helper function
+// post: returns the raster of function graphed the reference way in the window of testCase
+static string referenceRaster(const string &function, const Case &testCase) {
+    vector<string> polySplit = split(function);
+    Plane graph(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+    for (double xVal = -double(testCase.x); xVal <= double(testCase.x); xVal = xVal + 1/double(testCase.xSamples)) {
+        graph.addPoint(xVal, parsePolynomial(polySplit, xVal));
+    }
+    return graph.getRaster();
+}
+
+
+// referenceParametric helper function
+// post: graphs (a(x), b(x)) = (xParam, yParam) for tStart <= x <= tEnd into graph the reference way,
+// parsePolynomial at every x and addPoint for every point, and returns its header and rows
+template <class PlaneType>
+static string referenceParametric(PlaneType &graph, const string &xParam, const string &yParam, double tStart,
+                                  double tEnd, size_t tSamples) {
+    vector<string> xParaSplit = split(xParam), yParaSplit = split(yParam);
+    for (double tVal = tStart; tVal <= tEnd; tVal = tVal + 1/double(tSamples)) {
+        graph.addPoint(parsePolynomial(xParaSplit, tVal), parsePolynomial(yParaSplit, tVal));
+    }
+    ostringstream text;
+    graph.printHeader(text, xParam, yParam, tStart, tEnd);
+    graph.printRows(text, 0, graph.getYIndices());
+    return text.str();
+}
+
+
+// checkSparse helper function
+// post: checks that render, which renders testCase framed and sets stats, graphs it on a SparsePlane and
+// writes expected
+static void checkSparse(PathResult &path, const Case &testCase, const string &expected,
+                        const function<RenderStatus(ostream&, RenderStats*)> &render) {
+    ostringstream text;
+    RenderStats stats;
+    RenderStatus status = render(text, &stats);
+    if (status != RENDER_OK) {
+        path.checks++;
+        report(path, testCase, "returned status " + to_string(int(status)));
+    }
+    else if (stats.tileCount == 0) {
+        path.checks++;
+        report(path, testCase, "was not graphed on a SparsePlane");
+    }
+    else {
+        compareText(path, testCase, text.str(), expected);
+    }
+}
+
+
+// decodeSweep helper function
+// post: returns every frame of the sequence file filename, rebuilt from its keyframe and deltas. Throws
+// out_of_range if a run lands outside the frame
+static vector<string> decodeSweep(const string &filename, size_t rows) {
+    ifstream infile(filename);
+    vector<string> frames;
+    string line;
+    
+    // header lines end with a blank line
+    while (getline(infile, line) && !line.empty()) {
+        // skip
+    }
+    if (!getline(infile, line) || line.compare(0, 8, "KEYFRAME") != 0) {
+        return frames;
+    }
+    string raster;
+    for (size_t row = 0; row < rows && getline(infile, line); row++) {
+        raster += line;
+    }
+    frames.push_back(raster);
+    while (getline(infile, line) && line.compare(0, 5, "FRAME") == 0) {
+        size_t runs = stoul(line.substr(line.rfind(' ') + 1));
+        string current = frames.back();
+        size_t cell = 0;
+        for (size_t run = 0; run < runs && getline(infile, line); run++) {
+            size_t first = line.find(' ');
+            size_t second = line.find(' ', first + 1);
+            cell += stoul(line.substr(0, first));
+            size_t length = stoul(line.substr(first + 1, second - first - 1));
+            current.replace(cell, length, line.substr(second + 1, length));
+            cell += length;
+        }
+        frames.push_back(current);
+    }
+    return frames;
+}
+
+
+// checkSweep helper function
+// post: checks that every frame of a sweep of kx plus testCase's function, decoded from the sequence file
+// renderSweep writes, matches that frame graphed on its own the reference way. The sweep is timed into the
+// path, and graphing its frames on their own into framesTime
+static void checkSweep(PathResult &path, const Case &testCase, const string &filename, double &framesTime) {
+    string expression = "kx" + string(testCase.function[0] == '-' ? "" : "+") + testCase.function;
+    Clock::time_point start = Clock::now();
+    RenderStatus status = renderSweep(filename, expression, -1, 1, SWEEP_FRAMES, testCase.x, testCase.y,
+                                      testCase.xSamples, testCase.ySamples);
+    path.seconds += secondsSince(start);
+    vector<string> frames;
+    path.checks++;
+    if (status != RENDER_OK) {
+        report(path, testCase, "returned status " + to_string(int(status)));
+        return;
+    }
+    
+    // k is stepped exactly as renderSweep steps it
+    vector<string> functions, expected;
+    start = Clock::now();
+    for (size_t frame = 0; frame < SWEEP_FRAMES; frame++) {
+        functions.push_back(substituteParameter(expression, 'k', -1 + 2*double(frame)/double(SWEEP_FRAMES - 1)));
+        expected.push_back(referenceRaster(functions[frame], testCase));
+    }
+    framesTime += secondsSince(start);
+    
+    try {
+        frames = decodeSweep(filename, 2*testCase.y*testCase.ySamples + 1);
+    }
+    catch (std::exception &error) {
+        report(path, testCase, string("sequence file can't be decoded: ") + error.what());
+        return;
+    }
+    if (frames.size() != SWEEP_FRAMES) {
+        report(path, testCase, "sequence file holds " + to_string(frames.size()) + " frames");
+        return;
+    }
+    for (size_t frame = 0; frame < SWEEP_FRAMES; frame++) {
+        if (frames[frame] != expected[frame]) {
+            report(path, testCase, "frame " + to_string(frame) + ", " + functions[frame] + ", differs from the reference");
+            return;
+        }
+    }
+}
+
+
+// centralDifference helper function
+// post: returns (f(x + step) - f(x - step))/(2*step) for f = polySplit
+static double centralDifference(const vector<string> &polySplit, double xVal, double step) {
+    return (parsePolynomial(polySplit, xVal + step) - parsePolynomial(polySplit, xVal - step))/(2*step);
+}
+
+
+// checkSlopes helper function
+// post: checks slopes from dual numbers against central differences of the reference evaluation. Points
+// where the central differences with steps h, h/2 and h/4 don't agree, e.g. near a pole or where the
+// function oscillates faster than h, are skipped
+static void checkSlopes(PathResult &path, const Case &testCase, const Reference &reference, const vector<double> &slopes) {
+    path.checks++;
+    for (size_t index = 0; index < slopes.size(); index++) {
+        double xVal = reference.xs[index];
+        double step = SLOPE_STEP*(1 + std::fabs(xVal));
+        double coarse = centralDifference(reference.polySplit, xVal, step);
+        double middle = centralDifference(reference.polySplit, xVal, step/2);
+        double fine = centralDifference(reference.polySplit, xVal, step/4);
+        double scale = 1 + std::fabs(fine);
+        if (!(std::fabs(coarse - middle) <= 0.1*SLOPE_TOLERANCE*scale &&
+              std::fabs(middle - fine) <= 0.1*SLOPE_TOLERANCE*scale)) {
+            continue;
+        }
+        if (!(std::fabs(slopes[index] - fine) <= SLOPE_TOLERANCE*scale)) {
+            ostringstream detail;
+            detail.precision(17);
+            detail << "f'(" << xVal << ") = " << slopes[index] << ", central difference " << fine;
+            report(path, testCase, detail.str());
+            return;
+        }
+    }
+}
+
+
+// coarsenRaster helper function
+// pre: cells is a raster with columns x rows cells, whose origin is at column xOffset and row yOffset,
+// both even
+// post: returns the raster at half the samples per unit, in which a cell is filled if any cell of cells
+// whose center falls in it, rounded as Plane rounds it, is filled
+static string coarsenRaster(const string &cells, int columns, int rows, int xOffset, int yOffset) {
+    int coarseColumns = columns/2 + 1;
+    int coarseRows = rows/2 + 1;
+    string coarse(size_t(coarseColumns)*size_t(coarseRows), ' ');
+    for (int row = 0; row < rows; row++) {
+        int coarseRow = int(std::round(double(row - yOffset)/2)) + yOffset/2;
+        for (int column = 0; column < columns; column++) {
+            if (cells[size_t(row)*size_t(columns) + size_t(column)] == ' ') {
+                continue;
+            }
+            int coarseColumn = int(std::round(double(column - xOffset)/2)) + xOffset/2;
+            coarse[size_t(coarseRow)*size_t(coarseColumns) + size_t(coarseColumn)] = '*';
+        }
+    }
+    return coarse;
+}
+
+
+// checkPyramidLevels helper function
+// post: checks every level of pyramid coarser than the finest against the reference raster, OR-reduced
+// once per level. Cells of both are compared as filled or empty
+static void checkPyramidLevels(PathResult &path, const Case &testCase, const Reference &reference,
+                               const ZoomPyramid &pyramid) {
+    string cells = reference.raster;
+    int columns = int(2*testCase.x*testCase.xSamples + 1);
+    int rows = int(2*testCase.y*testCase.ySamples + 1);
+    for (size_t level = 1; level < pyramid.getLevelCount(); level++) {
+        size_t xSamples = pyramid.getXSample(level - 1), ySamples = pyramid.getYSample(level - 1);
+        cells = coarsenRaster(cells, columns, rows, int(testCase.x*xSamples), int(testCase.y*ySamples));
+        columns = columns/2 + 1;
+        rows = rows/2 + 1;
+        string cropped = pyramid.crop(testCase.x, testCase.y, pyramid.getXSample(level), pyramid.getYSample(level)).getRaster();
+        for (size_t cell = 0; cell < cropped.size(); cell++) {
+            cropped[cell] = cropped[cell] == ' ' ? ' ' : '*';
+        }
+        path.checks++;
+        if (cropped != cells) {
+            report(path, testCase, "level " + to_string(level) + " differs from the reference reduced " +
+                   to_string(level) + " times");
+        }
+    }
+}
+
+
+// checkPrecision helper function
+// post: checks that sampling with precision puts every point in the reference's cell, unless the reference
+// value is within tolerance of a boundary between cells
+static void checkPrecision(PathResult &path, const Case &testCase, const Reference &reference, Precision precision,
+                           double tolerance) {
+    Clock::time_point start = Clock::now();
+    vector<double> values(reference.xs.size());
+    parsePolynomial(reference.polySplit, reference.xs.data(), reference.xs.size(), values.data(), precision);
+    path.seconds += secondsSince(start);
+    
+    path.checks++;
+    bool excused = false;
+    for (size_t index = 0; index < values.size(); index++) {
+        if (cellRow(values[index], testCase.ySamples) == cellRow(reference.ys[index], testCase.ySamples)) {
+            continue;
+        }
+        if (std::isfinite(reference.ys[index]) && nearBoundary(reference.ys[index], testCase.ySamples, tolerance)) {
+            excused = true;
+            continue;
+        }
+        ostringstream detail;
+        detail.precision(17);
+        detail << "f(" << reference.xs[index] << ") = " << values[index] << " is in another cell than reference "
+               << reference.ys[index];
+        report(path, testCase, detail.str());
+        return;
+    }
+    path.excused += excused;
+}
+
+
+// sameLocations helper function
+// post: returns whether found and expected hold the same x values, in order, within ANALYSIS_TOLERANCE
+static bool sameLocations(const vector<double> &found, const vector<double> &expected) {
+    if (found.size() != expected.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < found.size(); index++) {
+        if (!(std::fabs(found[index] - expected[index]) <= ANALYSIS_TOLERANCE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// checkAnalysis helper function
+// post: checks that CurveAnalyzer finds the roots and extrema of analysisCase, from its samples added in
+// one batch and one at a time, so the state carried between batches is checked as well
+static void checkAnalysis(PathResult &path, const AnalysisCase &analysisCase) {
+    vector<string> polySplit = split(analysisCase.function);
+    vector<double> xs, ys;
+    for (double xVal = -analysisCase.end; xVal <= analysisCase.end; xVal = xVal + analysisCase.step) {
+        xs.push_back(xVal);
+        ys.push_back(parsePolynomial(polySplit, xVal));
+    }
+    Case testCase = {analysisCase.function, size_t(analysisCase.end), size_t(analysisCase.end),
+                     size_t(1/analysisCase.step), size_t(1/analysisCase.step)};
+    for (size_t batchSize = xs.size(); batchSize != 0; batchSize = batchSize == 1 ? 0 : 1) {
+        CurveAnalyzer analyzer([&](double xVal) { return parsePolynomial(polySplit, xVal); });
+        for (size_t first = 0; first < xs.size(); first += batchSize) {
+            analyzer.addSamples(&xs[first], &ys[first], std::min(batchSize, xs.size() - first));
+        }
+        analyzer.finish();
+        string batches = batchSize == 1 ? " with one sample per batch" : "";
+        path.checks++;
+        if (!sameLocations(analyzer.getRoots(), analysisCase.roots)) {
+            report(path, testCase, "found " + to_string(analyzer.getRoots().size()) + " roots, expected " +
+                   to_string(analysisCase.roots.size()) + batches);
+        }
+        else if (!sameLocations(analyzer.getMinima(), analysisCase.minima)) {
+            report(path, testCase, "found " + to_string(analyzer.getMinima().size()) + " minima, expected " +
+                   to_string(analysisCase.minima.size()) + batches);
+        }
+        else if (!sameLocations(analyzer.getMaxima(), analysisCase.maxima)) {
+            report(path, testCase, "found " + to_string(analyzer.getMaxima().size()) + " maxima, expected " +
+                   to_string(analysisCase.maxima.size()) + batches);
+        }
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    size_t cases = argc > 1 ? size_t(atol(argv[1])) : 300;
+    unsigned seed = argc > 2 ? unsigned(atol(argv[2])) : 1;
+    mt19937 rng(seed);
+    cout << "Fuzzing " << cases << " cases with seed " << seed << endl;
+    
+    PathResult paths[] = {
+        {"batched", EVALUATE, 0, 0, 0, 0},
+        {"float accurate", EVALUATE, 0, 0, 0, 0},
+        {"cell accurate", EVALUATE, 0, 0, 0, 0},
+        {"dual numbers", EVALUATE, 0, 0, 0, 0},
+        {"dual slopes", EVALUATE, 0, 0, 0, 0},
+        {"profiled", EVALUATE, 0, 0, 0, 0},
+        {"addPoints", RASTERIZE, 0, 0, 0, 0},
+        {"sparse plane", RASTERIZE, 0, 0, 0, 0},
+        {"library", RENDER, 0, 0, 0, 0},
+        {"library raster", RENDER, 0, 0, 0, 0},
+        {"library derivative", RENDER, 0, 0, 0, 0},
+        {"library sparse", RENDER, 0, 0, 0, 0},
+        {"parametric", PARAMETRIC, 0, 0, 0, 0},
+        {"parametric raster", PARAMETRIC, 0, 0, 0, 0},
+        {"sweep", FRAMES, 0, 0, 0, 0},
+        {"pyramid", RENDER, 0, 0, 0, 0},
+        {"pyramid levels", RENDER, 0, 0, 0, 0},
+        {"malformed", RENDER, 0, 0, 0, 0},
+        {"analysis", RENDER, 0, 0, 0, 0}
+    };
+    PathResult &batchPath = paths[0], &floatPath = paths[1], &cellPath = paths[2], &dualPath = paths[3];
+    PathResult &slopePath = paths[4], &profiledPath = paths[5], &addPointsPath = paths[6], &sparsePath = paths[7];
+    PathResult &libraryPath = paths[8], &rasterPath = paths[9], &derivativePath = paths[10];
+    PathResult &librarySparsePath = paths[11], &parametricPath = paths[12], &parametricRasterPath = paths[13];
+    PathResult &sweepPath = paths[14], &pyramidPath = paths[15], &pyramidLevelsPath = paths[16];
+    PathResult &malformedPath = paths[17], &analysisPath = paths[18];
+    size_t pathCount = sizeof(paths)/sizeof(paths[0]);
+    double baselineTime[5] = {0, 0, 0, 0, 0};
+    size_t skipped = 0;
+    string sweepFile = "fuzz." + to_string(seed) + ".sweep";
+    
+    // malformed functions must be rejected by the library, whatever the window
+    RenderParams malformedParams;
+    malformedParams.x_length = 2;
+    malformedParams.y_length = 2;
+    for (size_t index = 0; index < sizeof(MALFORMED)/sizeof(MALFORMED[0]); index++) {
+        ostringstream rejected;
+        malformedPath.checks++;
+        if (renderFunction(MALFORMED[index], malformedParams, FRAMED, rejected) != RENDER_INVALID_ARGUMENT) {
+            report(malformedPath, {MALFORMED[index], 2, 2, 1, 1}, "was not rejected");
+        }
+        // a sweep renders on worker threads, so it must reject the function before starting them
+        malformedPath.checks++;
+        if (renderSweep(sweepFile, MALFORMED[index], -1, 1, 2, 2, 2, 1, 1) != RENDER_INVALID_ARGUMENT) {
+            report(malformedPath, {MALFORMED[index], 2, 2, 1, 1}, "was not rejected by renderSweep");
+        }
+        // a pyramid samples on worker threads, so what they throw must reach this thread
+        malformedPath.checks++;
+        try {
+            vector<string> polySplit = split(MALFORMED[index]);
+            ZoomPyramid pyramid(2, 2, 1, 1, 1);
+            pyramid.build([&](double xVal) { return parsePolynomial(polySplit, xVal); });
+            report(malformedPath, {MALFORMED[index], 2, 2, 1, 1}, "was not rejected by ZoomPyramid::build");
+        }
+        catch (std::invalid_argument &error) {
+            // rejected by split, or by a term when evaluated
+        }
+    }
+    
+    // roots and extrema on samples and flat steps must be found, whatever the batches
+    for (size_t index = 0; index < sizeof(ANALYSIS_CASES)/sizeof(ANALYSIS_CASES[0]); index++) {
+        checkAnalysis(analysisPath, ANALYSIS_CASES[index]);
+    }
+    
+    // windows of more than SPARSE_CELL_LIMIT cells must be graphed on a SparsePlane, as the reference
+    // graphs them on one
+    RenderParams sparseParams;
+    sparseParams.x_length = SPARSE_WINDOW;
+    sparseParams.y_length = SPARSE_WINDOW;
+    for (size_t index = 0; index < sizeof(SPARSE_FUNCTIONS)/sizeof(SPARSE_FUNCTIONS[0]); index++) {
+        string function = SPARSE_FUNCTIONS[index];
+        SparsePlane expected(SPARSE_WINDOW, SPARSE_WINDOW, 1, 1);
+        vector<string> polySplit = split(function);
+        for (double xVal = -double(SPARSE_WINDOW); xVal <= double(SPARSE_WINDOW); xVal = xVal + 1) {
+            expected.addPoint(xVal, parsePolynomial(polySplit, xVal));
+        }
+        ostringstream expectedText;
+        expected.printHeader(expectedText, function);
+        expected.printRows(expectedText, 0, expected.getYIndices());
+        checkSparse(librarySparsePath, {function, SPARSE_WINDOW, SPARSE_WINDOW, 1, 1}, expectedText.str(),
+                    [&](ostream &out, RenderStats *stats) {
+                        return renderFunction(function, sparseParams, FRAMED, out, nullptr, stats);
+                    });
+    }
+    SparsePlane circle(SPARSE_WINDOW, SPARSE_WINDOW, 1, 1);
+    string circleText = referenceParametric(circle, SPARSE_X_PARAM, SPARSE_Y_PARAM, -SPARSE_T, SPARSE_T, 1);
+    checkSparse(librarySparsePath, {string(SPARSE_X_PARAM) + " , " + SPARSE_Y_PARAM, SPARSE_WINDOW, SPARSE_WINDOW, 1, 1},
+                circleText, [&](ostream &out, RenderStats *stats) {
+                    return renderParametric(SPARSE_X_PARAM, SPARSE_Y_PARAM, -SPARSE_T, SPARSE_T, sparseParams, FRAMED,
+                                            out, nullptr, stats);
+                });
+    
+    for (size_t caseCount = 0; caseCount < cases; caseCount++) {
+        Case testCase = randomCase(rng);
+        // b(x) of the parametric curve, with this case's function as a(x)
+        string yParam = randomCase(rng).function;
+        Reference reference;
+        try {
+            buildReference(testCase, reference, baselineTime[EVALUATE], baselineTime[RASTERIZE], baselineTime[RENDER]);
+        }
+        catch (std::exception &error) {
+            // the generator only writes functions the parser reads, so this is a bug in one or the other
+            cout << "reference: f(x) = " << testCase.function << " can't be parsed: " << error.what() << endl;
+            skipped++;
+            continue;
+        }
+        const vector<string> &polySplit = reference.polySplit;
+        size_t count = reference.xs.size();
+        function<double(double)> curve = [&](double xVal) { return parsePolynomial(polySplit, xVal); };
+        
+        // whole sweep in one batch, with exact and approximate trig precisions
+        Clock::time_point start = Clock::now();
+        vector<double> values(count), slopes(count);
+        parsePolynomial(polySplit, reference.xs.data(), count, values.data());
+        batchPath.seconds += secondsSince(start);
+        compareValues(batchPath, testCase, values, reference);
+        checkPrecision(floatPath, testCase, reference, FLOAT_ACCURATE, FLOAT_TOLERANCE);
+        checkPrecision(cellPath, testCase, reference, CELL_ACCURATE, CELL_TOLERANCE);
+        
+        // dual numbers, f and f' for the whole sweep in one batch
+        start = Clock::now();
+        parsePolynomialDual(polySplit, reference.xs.data(), count, values.data(), slopes.data());
+        dualPath.seconds += secondsSince(start);
+        compareValues(dualPath, testCase, values, reference);
+        checkSlopes(slopePath, testCase, reference, slopes);
+        
+        // profiling must not change values
+        start = Clock::now();
+        Profiler profiler(testCase.function);
+        parsePolynomial(polySplit, reference.xs.data(), count, values.data(), EXACT, &profiler);
+        profiledPath.seconds += secondsSince(start);
+        compareValues(profiledPath, testCase, values, reference);
+        
+        // batched rasterizing
+        start = Clock::now();
+        Plane batched(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+        batched.addPoints(reference.xs.data(), reference.ys.data(), count);
+        ostringstream batchedRows;
+        batched.printRows(batchedRows, 0, batched.getYIndices());
+        addPointsPath.seconds += secondsSince(start);
+        compareText(addPointsPath, testCase, batchedRows.str(), reference.rows);
+        
+        // sparse plane
+        start = Clock::now();
+        SparsePlane sparse(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+        sparse.addPoints(reference.xs.data(), reference.ys.data(), count);
+        ostringstream sparseText;
+        sparse.printHeader(sparseText, testCase.function);
+        sparse.printRows(sparseText, 0, sparse.getYIndices());
+        sparsePath.seconds += secondsSince(start);
+        compareText(sparsePath, testCase, sparseText.str(), reference.header + reference.rows);
+        
+        // library, framed and raster into a buffer
+        RenderParams params;
+        params.x_length = testCase.x;
+        params.y_length = testCase.y;
+        params.xSamples = testCase.xSamples;
+        params.ySamples = testCase.ySamples;
+        params.precision = EXACT;
+        params.derivative = false;
+        vector<char> buffer(reference.header.size() + reference.rows.size());
+        size_t written = 0;
+        PathResult *libraryPaths[] = {&libraryPath, &rasterPath};
+        for (size_t run = 0; run < 2; run++) {
+            RenderFormat format = run == 1 ? RASTER : FRAMED;
+            const string expected = format == RASTER ? reference.raster : reference.header + reference.rows;
+            start = Clock::now();
+            RenderStatus status = renderFunction(testCase.function, params, format, buffer.data(), buffer.size(), written);
+            libraryPaths[run]->seconds += secondsSince(start);
+            if (status != RENDER_OK) {
+                libraryPaths[run]->checks++;
+                report(*libraryPaths[run], testCase, "returned status " + to_string(int(status)));
+                continue;
+            }
+            compareText(*libraryPaths[run], testCase, string(buffer.data(), written), expected);
+        }
+        
+        // library with the derivative, against f' from scalar dual numbers drawn under f
+        Plane withDerivative(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+        for (size_t index = 0; index < count; index++) {
+            double slope = parsePolynomialDual(polySplit, reference.xs[index]).slope;
+            withDerivative.addPoints(&reference.xs[index], &slope, 1, DERIVATIVE_GLYPH);
+        }
+        for (size_t index = 0; index < count; index++) {
+            withDerivative.addPoint(reference.xs[index], reference.ys[index]);
+        }
+        ostringstream derivativeRows;
+        withDerivative.printRows(derivativeRows, 0, withDerivative.getYIndices());
+        params.derivative = true;
+        ostringstream derivativeText;
+        start = Clock::now();
+        RenderStatus status = renderFunction(testCase.function, params, FRAMED, derivativeText);
+        derivativePath.seconds += secondsSince(start);
+        params.derivative = false;
+        if (status != RENDER_OK) {
+            derivativePath.checks++;
+            report(derivativePath, testCase, "returned status " + to_string(int(status)));
+        }
+        else {
+            compareText(derivativePath, testCase, derivativeText.str(), reference.header + derivativeRows.str());
+        }
+        
+        // parametric curve of the function against another one for x across the window, framed and raster
+        // into a buffer, against the reference way of graphing it
+        Case parametricCase = {testCase.function + " , " + yParam, testCase.x, testCase.y, testCase.xSamples,
+                               testCase.ySamples};
+        double tEnd = double(testCase.x);
+        start = Clock::now();
+        Plane parametric(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples);
+        string parametricText = referenceParametric(parametric, testCase.function, yParam, -tEnd, tEnd, testCase.xSamples);
+        baselineTime[PARAMETRIC] += secondsSince(start);
+        string parametricRaster = parametric.getRaster();
+        vector<char> parametricBuffer(parametricText.size());
+        PathResult *parametricPaths[] = {&parametricPath, &parametricRasterPath};
+        for (size_t run = 0; run < 2; run++) {
+            RenderFormat format = run == 1 ? RASTER : FRAMED;
+            const string &expected = format == RASTER ? parametricRaster : parametricText;
+            start = Clock::now();
+            RenderStatus status = renderParametric(testCase.function, yParam, -tEnd, tEnd, params, format,
+                                                   parametricBuffer.data(), parametricBuffer.size(), written);
+            parametricPaths[run]->seconds += secondsSince(start);
+            if (status != RENDER_OK) {
+                parametricPaths[run]->checks++;
+                report(*parametricPaths[run], parametricCase, "returned status " + to_string(int(status)));
+                continue;
+            }
+            compareText(*parametricPaths[run], parametricCase, string(parametricBuffer.data(), written), expected);
+        }
+        
+        // parameter sweep over kx plus the function, rendered on many threads and decoded from its deltas
+        checkSweep(sweepPath, testCase, sweepFile, baselineTime[FRAMES]);
+        
+        // zoom pyramid with as many levels as the samples per unit can be halved for. The finest level,
+        // cropped to the whole window, must match the reference, and every coarser level its OR-reduction
+        size_t levels = 1;
+        while (levels < PYRAMID_LEVELS && testCase.xSamples % (size_t(1) << levels) == 0 &&
+               testCase.ySamples % (size_t(1) << levels) == 0) {
+            levels++;
+        }
+        start = Clock::now();
+        ZoomPyramid pyramid(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples, levels);
+        pyramid.build(curve);
+        string cropped = pyramid.crop(testCase.x, testCase.y, testCase.xSamples, testCase.ySamples).getRaster();
+        pyramidPath.seconds += secondsSince(start);
+        compareText(pyramidPath, testCase, cropped, reference.raster);
+        checkPyramidLevels(pyramidLevelsPath, testCase, reference, pyramid);
+        
+        // the case with a dangling sign, and without its closing parenthesis, must be rejected
+        vector<string> broken(1, testCase.function + "+");
+        if (testCase.function.back() == ')') {
+            broken.push_back(testCase.function.substr(0, testCase.function.length() - 1));
+        }
+        for (size_t index = 0; index < broken.size(); index++) {
+            RenderStatus status = renderFunction(broken[index], params, FRAMED, buffer.data(), buffer.size(), written);
+            malformedPath.checks++;
+            if (status != RENDER_INVALID_ARGUMENT) {
+                report(malformedPath, testCase, broken[index] + " was not rejected");
+            }
+        }
+    }
+    
+    std::remove(sweepFile.c_str());
+    
+    // formatting...
+    size_t mismatches = 0;
+    cout << endl << "Reference: " << (cases - skipped) << " cases, evaluate " << baselineTime[EVALUATE]*1e3
+         << " ms, rasterize " << baselineTime[RASTERIZE]*1e3 << " ms" << endl << endl;
+    for (size_t path = 0; path < pathCount; path++) {
+        const PathResult &result = paths[path];
+        double speedup = result.seconds > 0 ? baselineTime[result.baseline]/result.seconds : 0;
+        cout << result.name << ": " << result.checks << " checks, " << result.mismatches << " mismatches";
+        if (result.excused != 0) {
+            cout << ", " << result.excused << " cases with points moved across a cell boundary within tolerance";
+        }
+        // checks that only guard correctness, like malformed functions, aren't timed
+        if (result.seconds > 0) {
+            cout << ", " << result.seconds*1e3 << " ms, " << speedup << "x speedup over reference "
+                 << BASELINE_NAMES[result.baseline];
+        }
+        cout << endl;
+        mismatches += result.mismatches;
+    }
+    
+    return mismatches == 0 && skipped == 0 ? 0 : 1;
+}
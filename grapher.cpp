@@ -2,14 +2,23 @@
 // Author: John Kim
 // Email: john.j.kim@vanderbilt.edu
 // Description: Definitions of classes in "Plane.hpp"
-// Last Changed: 05/15/16
+// Last Changed: 10/19/26
 
 #include <iostream>
 #include <limits>
 #include <cmath>
 #include <vector>
 #include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <memory>
 #include "Plane.hpp"
+#include "Parser.hpp"
+#include "Sweep.hpp"
+#include "Render.hpp"
+#include "Analysis.hpp"
+#include "Pyramid.hpp"
 using namespace std;
 
 
@@ -19,34 +28,10 @@ using namespace std;
 // post: returns length
 size_t askLength(const char& axis);
 
-// parsePolynomial
-// read polynomial as string and return value at a given xVal
-// pre: polynomial in the form Ax^n+Bx^n-1+...+const
-// post: return value at given xVal
-double parsePolynomial(vector<string> polySplit, double xVal);
+// printSamples
+// post: prints each sampled point as (x , y)
+void printSamples(const double *xs, const double *ys, size_t count);
 
-// split
-// splits string by given value ch
-// post: returns pointer to string array containing substrings of original string, split by ch
-vector<string> split(string poly);
-
-// hasPow
-// post: returns whether str contains '^'
-bool hasPow(string term);
-
-// hasX
-// post: returns whether str contins 'x'
-bool hasX(string term);
-
-// getExp
-// pre: term hasPow
-// post: returns exponent
-int getExp(string term);
-
-// getCoeff
-// pre: has coefficient before x term
-// post: returns coefficient, or 1 if no coefficient before x term
-double getCoeff(string term, double xVal);
 
 
 int main() {
@@ -70,14 +55,32 @@ int main() {
     cout << "Enter Y window size (units): ";
     cin >> yWindow;
     
-    Plane graph(xWindow, yWindow, xSamples, ySamples);
+    size_t precisionType;
+    cout << "\n1. Exact\n2. Float accurate\n3. Cell accurate" << endl;
+    cout << "Enter the precision for trig functions (1, 2 or 3): ";
+    cin >> precisionType;
+    Precision precision = EXACT;
+    if (precisionType == 2) {
+        precision = FLOAT_ACCURATE;
+    }
+    else if (precisionType == 3) {
+        precision = CELL_ACCURATE;
+    }
+    
+    RenderParams params;
+    params.x_length = xWindow;
+    params.y_length = yWindow;
+    params.xSamples = xSamples;
+    params.ySamples = ySamples;
+    params.precision = precision;
+    params.derivative = false;
     
     size_t funcType;
     
-    cout << "\n\n1. Polynomial and/or Trigonometric\n2. Parametric" << endl;
-    cout << "Enter the type of function you would like to graph (1 or 2): ";
+    cout << "\n\n1. Polynomial and/or Trigonometric\n2. Parametric\n3. Parameter sweep\n4. Zoom pyramid\n5. Profile" << endl;
+    cout << "Enter the type of function you would like to graph (1, 2, 3, 4 or 5): ";
     cin >> funcType;
-    cout << "\n\n########################################################" << endl << "INPUT/OUTPUT GUIDELINES: \n1. Polynomials must be of the form Ax^n+Bx^n-1+...\n2. Functions may contain trig functions\n3. Trig functions must be entered as, for example, sin(polynomial)\n4. Parametric functions would be parametrized in terms of x\n5. If combining polynomials and trig functions, trig functions take precedence\n\t\"sin(x^2)*(5x^3+3)\" should be inputted as sin(x^2)5x^3+3\n########################################################\n\n";
+    cout << "\n\n########################################################" << endl << "INPUT/OUTPUT GUIDELINES: \n1. Polynomials must be of the form Ax^n+Bx^n-1+...\n2. Functions may contain trig functions\n3. Trig functions must be entered as, for example, sin(polynomial)\n4. Parametric functions would be parametrized in terms of x\n5. If combining polynomials and trig functions, trig functions take precedence\n\t\"sin(x^2)*(5x^3+3)\" should be inputted as sin(x^2)5x^3+3\n6. Parameter sweeps use k as the free parameter, in place of a coefficient or constant, e.g. sin(kx)\n7. The derivative of a function is drawn with \', and the function is drawn over it where they meet\n8. Zoom pyramids are sampled once at the samples per unit above. Each level halves the samples per unit, so they must be divisible by 2^(levels-1)\n9. Profiling graphs a function on one thread and ranks its terms, trig functions and stages by time\n########################################################\n\n";
     std::cout << "\n\nPress ENTER to continue...";
     std::cin.ignore( std::numeric_limits<std::streamsize>::max(), '\n' );
     std::cin.ignore( std::numeric_limits<std::streamsize>::max(), '\n' );
@@ -88,14 +91,48 @@ int main() {
             string polynomial;
             cout << "Enter the polynomial with no spaces: f(x) = ";
             cin >> polynomial;
+            char analyze;
+            cout << "Find roots, extrema and integral? (y/n): ";
+            cin >> analyze;
+            char derivative;
+            cout << "Also plot the derivative f'(x)? (y/n): ";
+            cin >> derivative;
             cout << endl;
-            vector<string> polySplit = split(polynomial);
-            for (double xVal = -xWindow; xVal <= xWindow; xVal = xVal + 1/double(graph.getXSample())) {
-                double yVal = parsePolynomial(polySplit, xVal);
-                graph.addPoint(xVal, yVal);
-                cout << "(" << xVal << " , " << yVal << ")" << endl;
+            params.derivative = derivative == 'y' || derivative == 'Y';
+            vector<string> polySplit;
+            try {
+                polySplit = split(polynomial);
+            }
+            catch (std::invalid_argument &error) {
+                cout << "Invalid Input" << endl;
+                break;
+            }
+            CurveAnalyzer analyzer([&](double xVal) { return parsePolynomial(polySplit, xVal, precision); });
+            SampleCallback onSamples = printSamples;
+            if (analyze == 'y' || analyze == 'Y') {
+                onSamples = [&](const double *xs, const double *ys, size_t count) {
+                    printSamples(xs, ys, count);
+                    analyzer.addSamples(xs, ys, count);
+                };
+            }
+            ofstream outfile;
+            outfile.open(outputFile, ios::ate);
+            RenderStats stats;
+            RenderStatus status = renderFunction(polynomial, params, FRAMED, outfile, onSamples, &stats);
+            outfile.close();
+            if (status != RENDER_OK) {
+                cout << "Invalid Input" << endl;
+                break;
+            }
+            if (stats.tileCount != 0) {
+                cout << "Sparse plane used " << stats.tileCount << " tiles, " << stats.memoryUsage << " bytes" << endl;
+            }
+            if (analyze == 'y' || analyze == 'Y') {
+                analyzer.finish();
+                analyzer.print(outputFile + ".analysis", polynomial);
+                cout << analyzer.getRoots().size() << " roots, " << analyzer.getMinima().size() << " minima and "
+                     << analyzer.getMaxima().size() << " maxima written to " << outputFile << ".analysis" << endl;
             }
-            graph.print(outputFile, polynomial);
             break;
         }
         case 2:
@@ -111,15 +148,117 @@ int main() {
             cout << "End x = ";
             cin >> tEnd;
             cout << endl;
-            vector<string> xParaSplit = split(xParametric);
-            vector<string> yParaSplit = split(yParametric);
-            for (double tVal = tStart; tVal <= tEnd; tVal = tVal + 1/double(graph.getXSample())) {
-                double xtVal = parsePolynomial(xParaSplit , tVal);
-                double ytVal = parsePolynomial(yParaSplit, tVal);
-                graph.addPoint(xtVal, ytVal);
-                cout << "(" << xtVal << " , " << ytVal << ")" << endl;
+            ofstream outfile;
+            outfile.open(outputFile, ios::ate);
+            RenderStats stats;
+            RenderStatus status = renderParametric(xParametric, yParametric, tStart, tEnd, params, FRAMED, outfile, printSamples, &stats);
+            outfile.close();
+            if (status != RENDER_OK) {
+                cout << "Invalid Input" << endl;
+            }
+            else if (stats.tileCount != 0) {
+                cout << "Sparse plane used " << stats.tileCount << " tiles, " << stats.memoryUsage << " bytes" << endl;
+            }
+            break;
+        }
+        case 3:
+        {
+            string expression;
+            double kStart, kEnd;
+            size_t frames;
+            cout << "Enter the function of x and k with no spaces: f(x) = ";
+            cin >> expression;
+            cout << "Start k = ";
+            cin >> kStart;
+            cout << "End k = ";
+            cin >> kEnd;
+            cout << "Number of frames: ";
+            cin >> frames;
+            cout << endl;
+            RenderStatus status = renderSweep(outputFile, expression, kStart, kEnd, frames, xWindow, yWindow,
+                                              xSamples, ySamples, precision);
+            if (status != RENDER_OK) {
+                cout << "Invalid Input" << endl;
+                break;
+            }
+            cout << frames << " frames written to " << outputFile << endl;
+            break;
+        }
+        case 4:
+        {
+            string polynomial;
+            size_t levelCount;
+            cout << "Enter the polynomial with no spaces: f(x) = ";
+            cin >> polynomial;
+            cout << "Number of zoom levels: ";
+            cin >> levelCount;
+            cout << endl;
+            vector<string> polySplit;
+            unique_ptr<ZoomPyramid> pyramid;
+            // a term that only fails when evaluated, like tan, is thrown by build on this thread
+            try {
+                polySplit = split(polynomial);
+                pyramid.reset(new ZoomPyramid(xWindow, yWindow, xSamples, ySamples, levelCount));
+                pyramid->build([&](double xVal) { return parsePolynomial(polySplit, xVal, precision); });
+            }
+            catch (std::invalid_argument &error) {
+                cout << error.what() << endl;
+                break;
+            }
+            cout << "Pyramid built with " << levelCount << " levels, " << pyramid->getMemoryUsage() << " bytes" << endl;
+            for (size_t level = 0; level < levelCount; level++) {
+                cout << "Level " << level << ": " << pyramid->getXSample(level) << " x " << pyramid->getYSample(level) << " samples per unit" << endl;
+            }
+            
+            size_t zoomCount = 0;
+            while (true) {
+                size_t zoomX, zoomY, zoomXSamples, zoomYSamples;
+                cout << "\nEnter zoom window x and y (units), then x and y samples per unit, or 0 0 0 0 to stop: ";
+                cin >> zoomX >> zoomY >> zoomXSamples >> zoomYSamples;
+                if (!cin || zoomXSamples == 0 || zoomYSamples == 0) {
+                    break;
+                }
+                try {
+                    string zoomFile = outputFile + "." + to_string(++zoomCount);
+                    pyramid->crop(zoomX, zoomY, zoomXSamples, zoomYSamples).print(zoomFile, polynomial);
+                    cout << "Zoom written to " << zoomFile << endl;
+                }
+                catch (std::invalid_argument &error) {
+                    zoomCount--;
+                    cout << error.what() << endl;
+                }
+            }
+            break;
+        }
+        case 5:
+        {
+            string polynomial;
+            char collapsed;
+            cout << "Enter the polynomial with no spaces: f(x) = ";
+            cin >> polynomial;
+            cout << "Also write collapsed stacks for flame graphs? (y/n): ";
+            cin >> collapsed;
+            cout << endl;
+            Profiler profiler("f(x) = " + polynomial);
+            ofstream outfile;
+            outfile.open(outputFile, ios::ate);
+            RenderStatus status = profileFunction(polynomial, params, outfile, profiler);
+            outfile.close();
+            if (status != RENDER_OK) {
+                cout << "Invalid Input" << endl;
+                break;
+            }
+            outfile.open(outputFile + ".profile", ios::ate);
+            profiler.printReport(outfile);
+            outfile.close();
+            profiler.printReport(cout);
+            cout << endl << "Profile written to " << outputFile << ".profile" << endl;
+            if (collapsed == 'y' || collapsed == 'Y') {
+                outfile.open(outputFile + ".folded", ios::ate);
+                profiler.printCollapsed(outfile);
+                outfile.close();
+                cout << "Collapsed stacks written to " << outputFile << ".folded" << endl;
             }
-            graph.print(outputFile, xParametric, yParametric, tStart, tEnd);
             break;
         }
         default:
@@ -146,223 +285,10 @@ size_t askLength(const char& axis) {
 }
 
 
-// parsePolynomial
-// return value at a given xVal
-// post: return value at given xVal
-double parsePolynomial(vector<string> polySplit, double xVal) {
-    double yVal = 0.0;
-    for (vector<string>::iterator iter = polySplit.begin(); iter < polySplit.end(); iter++) {
-        if (hasX(*iter)) {
-            if (hasPow(*iter)) {
-                yVal += getCoeff(*iter, xVal)*pow(xVal, getExp(*iter));
-            }
-            else {
-                yVal += getCoeff(*iter, xVal)*xVal;
-            }
-        }
-        // if function has power, but no X, check if trig function has power
-        else if (hasPow(*iter)) {
-            yVal += pow(getCoeff(*iter + "x", xVal), getExp(*iter));
-        }
-        else {
-            // either trig function or constant
-            bool isTrig = true;
-            size_t count = 0;
-            while (!isalpha((*iter)[count])) {
-                count++;
-                if (count == (*iter).length()) {
-                    // is a constant
-                    yVal += stod(*iter);
-                    isTrig = false;
-                }
-            }
-            if (isTrig) {
-                // else trig function
-                yVal += getCoeff(*iter + "x", xVal);
-            }
-        }
-        
-    }
-    return yVal;
-}
-
-
-// split
-// splits polynomial by char + or -. Ignores polynomials within trig functions
-// post: returns pointer to string array containing each term of polynomial
-vector<string> split(string poly) {
-    vector<string> polySplit;
-    string temp = "";
-    bool isNeg = false;
-    
-    // add first term
-    // we start at index 0 if the first term is positive, else we will start at index 1 and search
-    // for first occurence of '+' or '-'
-    size_t counter = size_t(poly[0] == '-');
-    if (counter) {
-        temp+= '-';
-    }
-    while (poly[counter] != '+' && poly[counter] != '-') {
-        temp += poly[counter];
-        counter++;
-        
-        // ignore polynomials/constants in trig functions, because they are included in the trig term
-        if (poly[counter] == '(') {
-            while (poly[counter] != ')') {
-                temp += poly[counter];
-                counter++;
-            }
-            // add last ')'
-            temp += poly[counter];
-            counter++;
-        }
-        // if polynomial has one term
-        if (counter == poly.length()) {
-            polySplit.push_back(temp);
-            return polySplit;
-        }
-    }
-    polySplit.push_back(temp);
-    temp = "";
-    
-    // add middle terms
-    for (size_t count = counter + 1; count < poly.length(); count++) {
-        if (poly[count] == '+') {
-            if (isNeg) {
-                polySplit.push_back("-" + temp);
-            }
-            else {
-                polySplit.push_back(temp);
-            }
-            temp = "";
-        }
-        else if (poly[count] == '-') {
-            if (isNeg) {
-                polySplit.push_back("-" + temp);
-            }
-            else {
-                polySplit.push_back(temp);
-            }
-            isNeg = true;
-            temp = "";
-        }
-        else {
-            temp += poly[count];
-        }
-    }
-    
-    // add last term
-    if (isNeg) {
-        polySplit.push_back("-" + temp);
-    }
-    else {
-        polySplit.push_back(temp);
-    }
-    
-    return polySplit;
-}
-
-
-// hasPow
-// post: returns whether str contains '^'. Does not include function inside a trig function
-bool hasPow(string term) {
-    size_t index = term.find(')');
-    if (index == -1) { index = 0; }
-    for (size_t count = index; count < term.length(); count++) {
-        if (term[count] == '^') {
-            return true;
-        }
-    }
-    return false;
-}
-
-
-// hasX
-// post: returns whether str contins 'x'; 'x' does not include occurrences within a trig function
-bool hasX(string term) {
-    size_t index = term.find(')');
-    if (index == -1) { index = 0; }
-    for (size_t count = index; count < term.length(); count++) {
-        if (term[count] == 'x') {
-            return true;
-        }
-    }
-    return false;
-}
-
-
-// getExp
-// pre: hasPow
-// post: returns exponent, does not include polynomial in trig function. Returns -1 if not found (should not occur)
-int getExp(string term) {
-    size_t index = term.find(')');
-    if (index == -1) { index = 0; }
-    for (size_t count = index; count < term.length(); count++) {
-        if (term[count] == '^') {
-            return int(count + 1);
-        }
-    }
-    return -1;
-}
-
-
-// getCoeff
-// pre: has coefficient before x-term. Coefficient can include trig functions
-// post: returns coefficient, or 1 if no coefficient before x term
-double getCoeff(string term, double xVal) {
-    // set index to end of trig function, if term contains one
-    int index = (int)term.find(')');
-    // if term contains no trig function, set it to zero
-    if (index == -1) { index = 0; }
-    
-    double coeff;
-    while (term[index] != 'x') {
-        index++;
-    }
-    if (term.substr(0, index) == "") {
-        return double(1);
-    }
-    else if (term.substr(0, index) == "-") {
-        return double(-1);
-    }
-    else {
-        // check if trig function
-        if (term.find('c') == -1 && term.find('s') == -1 && term.find('t') == -1) {
-            coeff = stod(term.substr(0, index));
-        }
-        else {
-            // check for correct trig function. term will be of the form const*trig_function(poly)
-            size_t trigIndex = 0;
-            // ignore coefficient
-            while (!isalpha(term[trigIndex])) {
-                trigIndex++;
-            }
-            char ch = term[trigIndex];
-            trigIndex += 4;
-            // extract polynomial inside trig function
-            string trigPoly = term.substr(trigIndex, index - trigIndex - 1);
-            
-            switch (ch) {
-                case 's':
-                {
-                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal)*sin(parsePolynomial(split(trigPoly), xVal));
-                    break;
-                }
-                case 'c':
-                {
-                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal)*cos(parsePolynomial(split(trigPoly), xVal));
-                    break;
-                }
-                case 't':
-                {
-                    coeff = getCoeff(term.substr(0, trigIndex - 4) + "x", xVal)*tan(parsePolynomial(split(trigPoly), xVal));
-                    break;
-                }
-                default :
-                    cout << "Something went wrong..." << endl;
-                    break;
-            }
-        }
+// printSamples
+// post: prints each sampled point as (x , y)
+void printSamples(const double *xs, const double *ys, size_t count) {
+    for (size_t pointCount = 0; pointCount < count; pointCount++) {
+        cout << "(" << xs[pointCount] << " , " << ys[pointCount] << ")" << endl;
     }
-    return coeff;
 }
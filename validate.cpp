@@ -0,0 +1,134 @@
+// File name: validate.cpp
+// Author: John Kim
+// Email: john.j.kim@vanderbilt.edu
+// Description: Checks that the approximate trig precisions in "FastMath.hpp" rasterize exactly like the
+// exact libm path. Every function in the corpus is rendered in several windows with each Precision, and
+// the Planes are compared cell for cell. Usage: validate [corpus file], where the corpus file holds one
+// function of x per line. Without a file, a built in corpus is used. Functions are sampled with the batched
+// parsePolynomial, so the approximations are checked through the array kernels every render uses. Returns 1
+// if any cell differs or any function of the corpus can't be parsed.
+// Last Changed: 10/19/26
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include "Plane.hpp"
+#include "Parser.hpp"
+using namespace std;
+
+// functions checked when no corpus file is given
+static const char *DEFAULT_CORPUS[] = {
+    "sin(x)", "cos(x)", "tan(x)", "3sin(x)", "-2cos(x)", "sin(2x)", "cos(x^2)", "sin(x^3)",
+    "tan(0.5x)", "2sin(x)+x", "cos(3x)-1", "sin(x)x", "-sin(x)", "0.5tan(x)+2", "sin(7x)", "cos(10x)+x^2",
+    "sin(x)+cos(x)", "4sin(0.3x^2)", "tan(2x)-x", "cos(-3x)"
+};
+
+// window size and samples per unit of each window the corpus is rendered in
+struct Window {
+    size_t x, y, xSamples, ySamples;
+};
+
+static const Window WINDOWS[] = {
+    {5, 5, 4, 4},
+    {10, 4, 10, 10},
+    {20, 20, 2, 2},
+    {3, 3, 30, 30}
+};
+
+// render helper function
+// post: returns raster of function sampled across window in one batch, as every render samples it, and
+// adds the largest difference between its samples and the exact samples to maxError
+string render(const vector<string> &polySplit, const Window &window, Precision precision, double &maxError) {
+    Plane graph(window.x, window.y, window.xSamples, window.ySamples);
+    vector<double> xVals;
+    for (double xVal = -double(window.x); xVal <= double(window.x); xVal = xVal + 1/double(window.xSamples)) {
+        xVals.push_back(xVal);
+    }
+    vector<double> yVals(xVals.size());
+    parsePolynomial(polySplit, xVals.data(), xVals.size(), yVals.data(), precision);
+    if (precision != EXACT) {
+        vector<double> exact(xVals.size());
+        parsePolynomial(polySplit, xVals.data(), xVals.size(), exact.data(), EXACT);
+        for (size_t index = 0; index < xVals.size(); index++) {
+            double error = std::fabs(yVals[index] - exact[index]);
+            // ignore samples far outside the window, e.g. near the poles of tan
+            if (std::fabs(yVals[index]) <= window.y && error > maxError) {
+                maxError = error;
+            }
+        }
+    }
+    graph.addPoints(xVals.data(), yVals.data(), xVals.size());
+    return graph.getRaster();
+}
+
+
+int main(int argc, char *argv[]) {
+    vector<string> corpus;
+    if (argc > 1) {
+        ifstream infile(argv[1]);
+        if (!infile) {
+            cout << "Could not open " << argv[1] << endl;
+            return 2;
+        }
+        string line;
+        while (infile >> line) {
+            corpus.push_back(line);
+        }
+    }
+    else {
+        corpus.assign(DEFAULT_CORPUS, DEFAULT_CORPUS + sizeof(DEFAULT_CORPUS)/sizeof(DEFAULT_CORPUS[0]));
+    }
+    
+    // a function that can't be parsed is reported and left out, rather than ending the run
+    vector<string> functions;
+    vector<vector<string> > polySplits;
+    size_t skipped = 0;
+    for (size_t function = 0; function < corpus.size(); function++) {
+        try {
+            vector<string> polySplit = split(corpus[function]);
+            parsePolynomial(polySplit, 0.0);
+            functions.push_back(corpus[function]);
+            polySplits.push_back(polySplit);
+        }
+        catch (std::invalid_argument &error) {
+            cout << "f(x) = " << corpus[function] << " can't be parsed: " << error.what() << endl;
+            skipped++;
+        }
+    }
+    
+    const Precision tiers[] = {FLOAT_ACCURATE, CELL_ACCURATE};
+    const char *tierNames[] = {"float accurate", "cell accurate"};
+    size_t windowCount = sizeof(WINDOWS)/sizeof(WINDOWS[0]);
+    size_t mismatches = 0;
+    
+    for (size_t tier = 0; tier < 2; tier++) {
+        size_t tierMismatches = 0;
+        double maxError = 0;
+        for (size_t function = 0; function < functions.size(); function++) {
+            const vector<string> &polySplit = polySplits[function];
+            for (size_t window = 0; window < windowCount; window++) {
+                double unused = 0;
+                string exact = render(polySplit, WINDOWS[window], EXACT, unused);
+                string approx = render(polySplit, WINDOWS[window], tiers[tier], maxError);
+                size_t cells = 0;
+                for (size_t count = 0; count < exact.length(); count++) {
+                    cells += exact[count] != approx[count];
+                }
+                if (cells != 0) {
+                    cout << tierNames[tier] << ": f(x) = " << functions[function] << " in window " << WINDOWS[window].x
+                         << " x " << WINDOWS[window].y << " at " << WINDOWS[window].xSamples << " x "
+                         << WINDOWS[window].ySamples << " samples per unit differs in " << cells << " cells" << endl;
+                }
+                tierMismatches += cells;
+            }
+        }
+        cout << tierNames[tier] << ": " << functions.size() << " functions, " << windowCount << " windows, "
+             << tierMismatches << " differing cells, largest sample error " << maxError << endl;
+        mismatches += tierMismatches;
+    }
+    
+    return mismatches == 0 && skipped == 0 ? 0 : 1;
+}